@@ -169,6 +169,11 @@ namespace ODDL
 				return (logicalSize - 1);
 			}
 
+			int32 GetAllocatedSize(void) const
+			{
+				return (physicalSize);
+			}
+
 			void Purge(void);
 			String& Set(const char *s, int32 length);
 
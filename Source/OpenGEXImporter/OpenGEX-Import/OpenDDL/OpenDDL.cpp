@@ -1657,15 +1657,305 @@ DataResult TypeDataType::ParseValue(const char *& text, PrimType *value)
 }
 
 
+thread_local MemoryAccounting *MemoryAccounting::currentAccounting = nullptr;
+
+
+MemoryAccounting::AccountedStructure::AccountedStructure(const Structure *s, StructureType type, int64 size)
+{
+	structure = s;
+	structureType = type;
+	nodeSize = size;
+	nameSize = 0;
+	payloadCategory = kMemoryPrimitiveArray;
+	payloadSize = 0;
+}
+
+
+MemoryAccounting::MemoryAccounting()
+{
+	Reset();
+}
+
+MemoryAccounting::~MemoryAccounting()
+{
+}
+
+MemoryAccounting::Entry *MemoryAccounting::GetEntry(StructureType type)
+{
+	int32 count = entryArray.GetElementCount();
+	for (machine a = 0; a < count; a++)
+	{
+		if (entryArray[a].structureType == type)
+		{
+			return (&entryArray[a]);
+		}
+	}
+
+	Entry entry;
+	entry.structureType = type;
+	for (machine a = 0; a < kMemoryCategoryCount; a++)
+	{
+		entry.liveBytes[a] = 0;
+		entry.peakBytes[a] = 0;
+	}
+
+	entryArray.AddElement(entry);
+	return (&entryArray[count]);
+}
+
+void MemoryAccounting::Reset(void)
+{
+	entryArray.Purge();
+	structureMap.Purge();
+
+	for (machine a = 0; a < kMemoryCategoryCount; a++)
+	{
+		categoryLiveBytes[a] = 0;
+		categoryPeakBytes[a] = 0;
+	}
+
+	totalLiveBytes = 0;
+	totalPeakBytes = 0;
+}
+
+void MemoryAccounting::Account(StructureType type, MemoryCategory category, int64 size)
+{
+	if (size == 0)
+	{
+		return;
+	}
+
+	Entry *entry = GetEntry(type);
+	int64 live = (entry->liveBytes[category] += size);
+	if (live > entry->peakBytes[category])
+	{
+		entry->peakBytes[category] = live;
+	}
+
+	live = (categoryLiveBytes[category] += size);
+	if (live > categoryPeakBytes[category])
+	{
+		categoryPeakBytes[category] = live;
+	}
+
+	live = (totalLiveBytes += size);
+	if (live > totalPeakBytes)
+	{
+		totalPeakBytes = live;
+	}
+}
+
+void MemoryAccounting::AddStructure(const Structure *structure, StructureType type, int64 nodeSize)
+{
+	structureMap.Insert(new AccountedStructure(structure, type, nodeSize));
+	Account(type, kMemoryStructureNode, nodeSize);
+}
+
+void MemoryAccounting::RemoveStructure(const Structure *structure)
+{
+	AccountedStructure *accounted = structureMap.Find(structure);
+	if (accounted)
+	{
+		Account(accounted->structureType, kMemoryStructureNode, -accounted->nodeSize);
+		Account(accounted->structureType, kMemoryString, -accounted->nameSize);
+		Account(accounted->structureType, accounted->payloadCategory, -accounted->payloadSize);
+		delete accounted;
+	}
+}
+
+void MemoryAccounting::AccountName(const Structure *structure, int64 size)
+{
+	AccountedStructure *accounted = structureMap.Find(structure);
+	if (accounted)
+	{
+		Account(accounted->structureType, kMemoryString, size - accounted->nameSize);
+		accounted->nameSize = size;
+	}
+}
+
+void MemoryAccounting::AccountPayload(const Structure *structure, MemoryCategory category, int64 size)
+{
+	AccountedStructure *accounted = structureMap.Find(structure);
+	if (accounted)
+	{
+		Account(accounted->structureType, accounted->payloadCategory, -accounted->payloadSize);
+		Account(accounted->structureType, category, size);
+
+		accounted->payloadCategory = category;
+		accounted->payloadSize = size;
+	}
+}
+
+namespace
+{
+	const char *const memoryCategoryName[kMemoryCategoryCount] =
+	{
+		"node", "string", "primitive", "index", "bone"
+	};
+
+	void AppendInteger(String& text, int64 value)
+	{
+		char	buffer[24];
+
+		bool negative = (value < 0);
+		unsigned_int64 v = (negative) ? (unsigned_int64) -value : (unsigned_int64) value;
+
+		char *c = &buffer[23];
+		*c = 0;
+		do
+		{
+			*--c = (char) ('0' + v % 10);
+			v /= 10;
+		} while (v != 0);
+
+		if (negative)
+		{
+			*--c = '-';
+		}
+
+		text += c;
+	}
+
+	void AppendStructureType(String& text, StructureType type)
+	{
+		if (type == kStructureRoot)
+		{
+			text += "root";
+			return;
+		}
+
+		for (machine shift = 24; shift >= 0; shift -= 8)
+		{
+			char k = (char) ((type >> shift) & 0xFF);
+			text += ((k >= 0x20) && (k < 0x7F)) ? k : '?';
+		}
+	}
+}
+
+String MemoryAccounting::GetSummary(void) const
+{
+	String text("total live ");
+	AppendInteger(text, totalLiveBytes);
+	text += " peak ";
+	AppendInteger(text, totalPeakBytes);
+	text += '\n';
+
+	for (machine a = 0; a < kMemoryCategoryCount; a++)
+	{
+		text += memoryCategoryName[a];
+		text += " live ";
+		AppendInteger(text, categoryLiveBytes[a]);
+		text += " peak ";
+		AppendInteger(text, categoryPeakBytes[a]);
+		text += '\n';
+	}
+
+	int32 count = entryArray.GetElementCount();
+	for (machine a = 0; a < count; a++)
+	{
+		const Entry& entry = entryArray[a];
+		for (machine b = 0; b < kMemoryCategoryCount; b++)
+		{
+			if (entry.peakBytes[b] != 0)
+			{
+				AppendStructureType(text, entry.structureType);
+				text += ' ';
+				text += memoryCategoryName[b];
+				text += " live ";
+				AppendInteger(text, entry.liveBytes[b]);
+				text += " peak ";
+				AppendInteger(text, entry.peakBytes[b]);
+				text += '\n';
+			}
+		}
+	}
+
+	return (text);
+}
+
+
+#if ODDL_MEMORY_ACCOUNTING
+
+	thread_local unsigned_int32 Structure::pendingNodeSize = 0;
+
+#endif
+
 Structure::Structure(StructureType type)
 {
 	structureType = type;
 	baseStructureType = 0;
 	globalNameFlag = true;
+
+	#if ODDL_MEMORY_ACCOUNTING
+
+		// The size of the most derived object is only known to operator new, which runs right before this.
+
+		MemoryAccounting *accounting = MemoryAccounting::GetCurrent();
+		if (accounting)
+		{
+			accounting->AddStructure(this, type, pendingNodeSize);
+		}
+
+		pendingNodeSize = 0;
+
+	#endif
 }
 
 Structure::~Structure()
 {
+	#if ODDL_MEMORY_ACCOUNTING
+
+		// Structures that were not created under the current accounting object are not found in its table.
+
+		MemoryAccounting *accounting = MemoryAccounting::GetCurrent();
+		if (accounting)
+		{
+			accounting->RemoveStructure(this);
+		}
+
+	#endif
+}
+
+void *Structure::operator new(size_t size)
+{
+	#if ODDL_MEMORY_ACCOUNTING
+
+		pendingNodeSize = (unsigned_int32) size;
+
+	#endif
+
+	return (::operator new(size));
+}
+
+void Structure::operator delete(void *ptr)
+{
+	::operator delete(ptr);
+}
+
+bool Structure::MemoryAccountingEnabled(void) const
+{
+	#if ODDL_MEMORY_ACCOUNTING
+
+		return (MemoryAccounting::GetCurrent() != nullptr);
+
+	#else
+
+		return (false);
+
+	#endif
+}
+
+void Structure::SetAccountedPayload(MemoryCategory category, int64 size)
+{
+	#if ODDL_MEMORY_ACCOUNTING
+
+		MemoryAccounting *accounting = MemoryAccounting::GetCurrent();
+		if (accounting)
+		{
+			accounting->AccountPayload(this, category, size);
+		}
+
+	#endif
 }
 
 Structure *Structure::GetFirstSubstructure(StructureType type) const
@@ -1778,6 +2068,19 @@ template <class type> DataStructure<type>::~DataStructure()
 {
 }
 
+namespace
+{
+	template <typename type> inline int64 GetPrimitiveAllocatedSize(const type& value)
+	{
+		return (0);
+	}
+
+	inline int64 GetPrimitiveAllocatedSize(const String& value)
+	{
+		return (value.GetAllocatedSize());
+	}
+}
+
 template <class type> DataResult DataStructure<type>::ParseData(const char *& text)
 {
 	int32 count = 0;
@@ -1867,6 +2170,18 @@ template <class type> DataResult DataStructure<type>::ParseData(const char *& te
 		}
 	}
 
+	if (MemoryAccountingEnabled())
+	{
+		int32 elementCount = dataArray.GetElementCount();
+		int64 size = elementCount * sizeof(PrimType);
+		for (machine a = 0; a < elementCount; a++)
+		{
+			size += GetPrimitiveAllocatedSize(dataArray[a]);
+		}
+
+		SetAccountedPayload(((StructureType) type::kStructureType == kDataString) ? kMemoryString : kMemoryPrimitiveArray, size);
+	}
+
 	return (kDataOkay);
 }
 
@@ -1887,6 +2202,8 @@ bool RootStructure::ValidateSubstructure(const DataDescription *dataDescription,
 
 DataDescription::DataDescription()
 {
+	memoryAccountingFlag = false;
+	structureCount = 0;
 }
 
 DataDescription::~DataDescription()
@@ -2116,6 +2433,7 @@ DataResult DataDescription::ParseStructures(const char *& text, Structure *root)
 		}
 
 		identifier.Purge();
+		structureCount++;
 
 		AutoDelete<Structure> structurePtr(structure);
 		structure->textLocation = text;
@@ -2178,6 +2496,15 @@ DataResult DataDescription::ParseStructures(const char *& text, Structure *root)
 
 			Data::ReadIdentifier(text, &length, structure->structureName.SetLength(length));
 
+			#if ODDL_MEMORY_ACCOUNTING
+
+				if (memoryAccountingFlag)
+				{
+					memoryAccounting.AccountName(structure, structure->structureName.GetAllocatedSize());
+				}
+
+			#endif
+
 			bool global = (c == '$');
 			structure->globalNameFlag = global;
 
@@ -2267,8 +2594,18 @@ DataResult DataDescription::ProcessText(const char *text)
 {
 	rootStructure.PurgeSubtree();
 
+	// Structures created on this thread from here on charge their memory to this description.
+
+	MemoryAccounting *previousAccounting = MemoryAccounting::currentAccounting;
+	if (memoryAccountingFlag)
+	{
+		memoryAccounting.Reset();
+		MemoryAccounting::currentAccounting = &memoryAccounting;
+	}
+
 	errorStructure = nullptr;
 	errorLine = 0;
+	structureCount = 0;
 
 	const char *start = text;
 	text += Data::GetWhitespaceLength(text);
@@ -2304,5 +2641,23 @@ DataResult DataDescription::ProcessText(const char *text)
 		errorLine = line;
 	}
 
+	if (memoryAccountingFlag)
+	{
+		MemoryAccounting::currentAccounting = previousAccounting;
+		DumpMemoryAccounting(&memoryAccounting);
+	}
+
 	return (result);
 }
+
+void DataDescription::DumpMemoryAccounting(const MemoryAccounting *accounting)
+{
+}
+
+void DataDescription::RunParallelJobs(int32 jobCount, ParallelJobProc *proc, void *cookie)
+{
+	for (machine a = 0; a < jobCount; a++)
+	{
+		(*proc)((int32) a, cookie);
+	}
+}
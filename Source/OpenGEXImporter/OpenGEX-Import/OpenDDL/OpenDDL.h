@@ -54,6 +54,15 @@
 #include "ODDLMap.h"
 
 
+//# Memory accounting can be compiled out entirely by defining $ODDL_MEMORY_ACCOUNTING$ as 0. When compiled in,
+//# structures carry no bookkeeping of their own, so it costs nothing per structure until it is enabled for a
+//# $@DataDescription@$.
+
+#ifndef ODDL_MEMORY_ACCOUNTING
+#define ODDL_MEMORY_ACCOUNTING 1
+#endif
+
+
 namespace ODDL
 {
 	typedef unsigned_int32		DataResult;
@@ -136,6 +145,7 @@ namespace ODDL
 	};
 
 
+	class Structure;
 	class DataDescription;
 
 
@@ -470,6 +480,132 @@ namespace ODDL
 	};
 
 
+	enum MemoryCategory
+	{
+		kMemoryStructureNode,			//## The structure objects themselves.
+		kMemoryString,					//## Structure names and the contents of string data structures.
+		kMemoryPrimitiveArray,			//## The element storage of primitive data structures.
+		kMemoryIndexArray,				//## Index data widened or expanded by a derivative format.
+		kMemoryBoneArray,				//## Bone data copied by a derivative format.
+		kMemoryCategoryCount
+	};
+
+
+	//# \class	MemoryAccounting		Tracks the memory held by the structures of a data description.
+	//
+	//# The $MemoryAccounting$ class tracks live and peak bytes by structure type and $MemoryCategory$.
+	//
+	//# \def	class MemoryAccounting
+	//
+	//# \desc
+	//# A $MemoryAccounting$ object belongs to a $@DataDescription@$ and is only filled while accounting is enabled with
+	//# the $@DataDescription::SetMemoryAccountingEnabled@$ function. The sizes charged for each structure are kept in a
+	//# table owned by the accounting object, so that structures carry no bookkeeping of their own. Memory is released
+	//# when a structure is destroyed while its data description is processing text, so the counts are final once the
+	//# $@DataDescription::ProcessText@$ function returns. The byte counts include the storage owned by a structure, not
+	//# allocator overhead.
+
+	class MemoryAccounting
+	{
+		public:
+
+			struct Entry
+			{
+				StructureType	structureType;
+				int64			liveBytes[kMemoryCategoryCount];
+				int64			peakBytes[kMemoryCategoryCount];
+			};
+
+		private:
+
+			class AccountedStructure : public MapElement<AccountedStructure>
+			{
+				public:
+
+					typedef const Structure *KeyType;
+
+					const Structure		*structure;
+					StructureType		structureType;
+					int64				nodeSize;
+					int64				nameSize;
+					MemoryCategory		payloadCategory;
+					int64				payloadSize;
+
+					AccountedStructure(const Structure *s, StructureType type, int64 size);
+
+					KeyType GetKey(void) const
+					{
+						return (structure);
+					}
+			};
+
+			Array<Entry>				entryArray;
+			Map<AccountedStructure>		structureMap;
+
+			int64				categoryLiveBytes[kMemoryCategoryCount];
+			int64				categoryPeakBytes[kMemoryCategoryCount];
+			int64				totalLiveBytes;
+			int64				totalPeakBytes;
+
+			static thread_local MemoryAccounting	*currentAccounting;
+
+			friend class Structure;
+			friend class DataDescription;
+
+			Entry *GetEntry(StructureType type);
+
+			void AddStructure(const Structure *structure, StructureType type, int64 nodeSize);
+			void RemoveStructure(const Structure *structure);
+			void AccountName(const Structure *structure, int64 size);
+			void AccountPayload(const Structure *structure, MemoryCategory category, int64 size);
+
+		public:
+
+			MemoryAccounting();
+			~MemoryAccounting();
+
+			int32 GetEntryCount(void) const
+			{
+				return (entryArray.GetElementCount());
+			}
+
+			const Entry& GetEntry(int32 index) const
+			{
+				return (entryArray[index]);
+			}
+
+			int64 GetCategoryLiveBytes(MemoryCategory category) const
+			{
+				return (categoryLiveBytes[category]);
+			}
+
+			int64 GetCategoryPeakBytes(MemoryCategory category) const
+			{
+				return (categoryPeakBytes[category]);
+			}
+
+			int64 GetTotalLiveBytes(void) const
+			{
+				return (totalLiveBytes);
+			}
+
+			int64 GetTotalPeakBytes(void) const
+			{
+				return (totalPeakBytes);
+			}
+
+			static MemoryAccounting *GetCurrent(void)
+			{
+				return (currentAccounting);
+			}
+
+			void Reset(void);
+			void Account(StructureType type, MemoryCategory category, int64 size);
+
+			String GetSummary(void) const;
+	};
+
+
 	//# \class	Structure		Represents a data structure in an OpenDDL file.
 	//
 	//# The $Structure$ class represents a data structure in an OpenDDL file.
@@ -743,6 +879,12 @@ namespace ODDL
 
 			const char			*textLocation;
 
+			#if ODDL_MEMORY_ACCOUNTING
+
+				static thread_local unsigned_int32		pendingNodeSize;
+
+			#endif
+
 		protected:
 
 			Structure(StructureType type);
@@ -752,8 +894,14 @@ namespace ODDL
 				baseStructureType = type;
 			}
 
+			bool MemoryAccountingEnabled(void) const;
+			void SetAccountedPayload(MemoryCategory category, int64 size);
+
 		public:
 
+			static void *operator new(size_t size);
+			static void operator delete(void *ptr);
+
 			virtual ~Structure();
 
 			using Tree<Structure>::Previous;
@@ -1143,6 +1291,39 @@ namespace ODDL
 	//# \also	$@DataDescription::GetErrorLine@$
 
 
+	//# \function	DataDescription::SetMemoryAccountingEnabled		Enables memory accounting for the structures of a data description.
+	//
+	//# \proto	void SetMemoryAccountingEnabled(bool enabled);
+	//
+	//# \param	enabled		Whether the next calls to $@DataDescription::ProcessText@$ account for memory.
+	//
+	//# \desc
+	//# While memory accounting is enabled, the $@DataDescription::ProcessText@$ function resets the $@MemoryAccounting@$
+	//# object returned by the $@DataDescription::GetMemoryAccounting@$ function, records the memory of every structure
+	//# it creates, and calls the $DumpMemoryAccounting$ function before it returns. The default implementation of the
+	//# $DumpMemoryAccounting$ function does nothing, a subclass can override it to write $@MemoryAccounting::GetSummary@$
+	//# to its log. Memory accounting is disabled by default.
+	//
+	//# \also	$@DataDescription::GetMemoryAccounting@$
+
+
+	//# \function	DataDescription::RunParallelJobs		Runs a number of independent jobs, possibly in parallel.
+	//
+	//# \proto	virtual void RunParallelJobs(int32 jobCount, ParallelJobProc *proc, void *cookie);
+	//
+	//# \param	jobCount	The number of jobs to run.
+	//# \param	proc		The function called once for each job, with the job index and the $cookie$ parameter.
+	//# \param	cookie		A pointer passed through to the $proc$ function.
+	//
+	//# \desc
+	//# The $RunParallelJobs$ function is called by $@Structure::ProcessData@$ implementations that split large
+	//# amounts of data into independent jobs. It must not return before every job has finished. The jobs never
+	//# touch the same data, so a subclass can override this function to distribute them over the threads of a
+	//# job system. The default implementation runs the jobs one after another on the calling thread.
+	//
+	//# \also	$@Structure::ProcessData@$
+
+
 	//# \function	DataDescription::GetErrorLine		Returns the line on which an error occurred.
 	//
 	//# \proto	int32 GetErrorLine(void) const;
@@ -1155,18 +1336,35 @@ namespace ODDL
 	//# \also	$@DataDescription::ProcessText@$
 
 
+	//# \function	DataDescription::GetStructureCount		Returns the number of structures parsed.
+	//
+	//# \proto	int32 GetStructureCount(void) const;
+	//
+	//# \desc
+	//# The $GetStructureCount$ function returns the number of structures, including primitive data structures, that were
+	//# created while parsing the text passed to the most recent call to the $@DataDescription::ProcessText@$ function.
+	//# The count is kept as the structures are created, so reading it does not walk the structure tree.
+	//
+	//# \also	$@DataDescription::ProcessText@$
+
+
 	class DataDescription
 	{
 		friend Structure;
 
 		private:
 
+			MemoryAccounting	memoryAccounting;
+			bool				memoryAccountingFlag;
+
 			Map<Structure>		structureMap;
 			RootStructure		rootStructure;
 
 			const Structure		*errorStructure;
 			int32				errorLine;
 
+			int32				structureCount;
+
 			static Structure *CreatePrimitive(const String& identifier);
 
 			DataResult ParseProperties(const char *& text, Structure *structure);
@@ -1177,6 +1375,7 @@ namespace ODDL
 			DataDescription();
 
 			virtual DataResult ProcessData(void);
+			virtual void DumpMemoryAccounting(const MemoryAccounting *accounting);
 
 		public:
 
@@ -1192,8 +1391,27 @@ namespace ODDL
 				return (errorLine);
 			}
 
+			int32 GetStructureCount(void) const
+			{
+				return (structureCount);
+			}
+
+			const MemoryAccounting *GetMemoryAccounting(void) const
+			{
+				return (&memoryAccounting);
+			}
+
+			void SetMemoryAccountingEnabled(bool enabled)
+			{
+				memoryAccountingFlag = enabled;
+			}
+
 			Structure *FindStructure(const StructureRef& reference) const;
 
+			typedef void ParallelJobProc(int32 jobIndex, void *cookie);
+
+			virtual void RunParallelJobs(int32 jobCount, ParallelJobProc *proc, void *cookie);
+
 			virtual Structure *CreateStructure(const String& identifier) const;
 			virtual bool ValidateTopLevelStructure(const Structure *structure) const;
 
@@ -44,10 +44,161 @@
 #include "OpenGEX.h"
 //#include <windows.h>
 
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 1))
+
+	#include <xmmintrin.h>
+
+	#define OPENGEX_SSE 1
+
+#endif
+
 
 using namespace OGEX;
 
 
+namespace
+{
+	void SetIdentityMatrix(float *matrix)
+	{
+		for (machine a = 0; a < 16; a++)
+		{
+			matrix[a] = ((a & 3) == (a >> 2)) ? 1.0F : 0.0F;
+		}
+	}
+
+	// Multiplies two column-major matrices. The result must not alias either input.
+	void MultiplyMatrix(const float *a, const float *b, float *result)
+	{
+		for (machine column = 0; column < 4; column++)
+		{
+			for (machine row = 0; row < 4; row++)
+			{
+				result[column * 4 + row] = a[row] * b[column * 4] + a[4 + row] * b[column * 4 + 1] + a[8 + row] * b[column * 4 + 2] + a[12 + row] * b[column * 4 + 3];
+			}
+		}
+	}
+
+	// Finds the smallest and largest coordinates of an array of points with the given number of floats each.
+	// Coordinates past the third are ignored, and missing ones count as zero.
+	void CalculatePointBounds(int32 pointCount, int32 pointSize, const float *point, float *minimum, float *maximum)
+	{
+		minimum[0] = minimum[1] = minimum[2] = 0.0F;
+		maximum[0] = maximum[1] = maximum[2] = 0.0F;
+		if ((pointCount <= 0) || (pointSize <= 0))
+		{
+			return;
+		}
+
+		int32 coordCount = (pointSize < 3) ? pointSize : 3;
+		for (machine k = 0; k < coordCount; k++)
+		{
+			minimum[k] = maximum[k] = point[k];
+		}
+
+		machine a = 1;
+
+		#if OPENGEX_SSE
+
+			// Each point is loaded as four floats at once, so the last point of a tightly packed array is
+			// left to the scalar loop below to avoid reading past the end of the data.
+
+			if (pointSize >= 3)
+			{
+				machine vectorCount = (pointSize >= 4) ? pointCount : pointCount - 1;
+				if (vectorCount > 1)
+				{
+					__m128 vmin = _mm_loadu_ps(point);
+					__m128 vmax = vmin;
+					for (; a < vectorCount; a++)
+					{
+						__m128 v = _mm_loadu_ps(point + a * pointSize);
+						vmin = _mm_min_ps(vmin, v);
+						vmax = _mm_max_ps(vmax, v);
+					}
+
+					float vector[4];
+					_mm_storeu_ps(vector, vmin);
+					minimum[0] = vector[0];
+					minimum[1] = vector[1];
+					minimum[2] = vector[2];
+
+					_mm_storeu_ps(vector, vmax);
+					maximum[0] = vector[0];
+					maximum[1] = vector[1];
+					maximum[2] = vector[2];
+				}
+			}
+
+		#endif
+
+		for (; a < pointCount; a++)
+		{
+			const float *p = point + a * pointSize;
+			for (machine k = 0; k < coordCount; k++)
+			{
+				minimum[k] = (p[k] < minimum[k]) ? p[k] : minimum[k];
+				maximum[k] = (p[k] > maximum[k]) ? p[k] : maximum[k];
+			}
+		}
+	}
+
+	// Transforms axis-aligned bounds by a column-major matrix into the axis-aligned bounds that enclose the result.
+	void TransformBounds(const float *matrix, const float *minimum, const float *maximum, float *resultMin, float *resultMax)
+	{
+		for (machine row = 0; row < 3; row++)
+		{
+			float center = matrix[12 + row];
+			float extent = 0.0F;
+			for (machine column = 0; column < 3; column++)
+			{
+				float m = matrix[column * 4 + row];
+				center += m * (minimum[column] + maximum[column]) * 0.5F;
+				extent += ((m < 0.0F) ? -m : m) * (maximum[column] - minimum[column]) * 0.5F;
+			}
+
+			resultMin[row] = center - extent;
+			resultMax[row] = center + extent;
+		}
+	}
+
+	float EvaluateBezier(float p0, float p1, float p2, float p3, float s)
+	{
+		float t = 1.0F - s;
+		return (t * t * t * p0 + 3.0F * s * t * t * p1 + 3.0F * s * s * t * p2 + s * s * s * p3);
+	}
+
+	// Finds the curve parameter at which a Bezier time segment reaches the given time. The time curve is
+	// monotonic, so Newton iterations started from the linear guess converge quickly, with bisection as
+	// a fallback whenever a step would leave the bracketing interval.
+	float SolveBezierTime(float t0, float c0, float c1, float t1, float time)
+	{
+		float low = 0.0F;
+		float high = 1.0F;
+		float s = (time - t0) / (t1 - t0);
+
+		for (machine a = 0; a < 8; a++)
+		{
+			float f = EvaluateBezier(t0, c0, c1, t1, s) - time;
+			if (f < 0.0F)
+			{
+				low = s;
+			}
+			else
+			{
+				high = s;
+			}
+
+			float u = 1.0F - s;
+			float d = 3.0F * (u * u * (c0 - t0) + 2.0F * s * u * (c1 - c0) + s * s * (t1 - c1));
+			float next = (d != 0.0F) ? s - f / d : low - 1.0F;
+			s = ((next > low) && (next < high)) ? next : (low + high) * 0.5F;
+		}
+
+		return (s);
+	}
+}
+
+
 OpenGexStructure::OpenGexStructure(StructureType type) : Structure(type)
 {
 }
@@ -387,6 +538,7 @@ MatrixStructure::MatrixStructure(StructureType type) : AnimatableStructure(type)
 	SetBaseStructureType(kStructureMatrix);
 
 	objectFlag = false;
+	matrixData = nullptr;
 }
 
 MatrixStructure::~MatrixStructure()
@@ -447,9 +599,18 @@ DataResult TransformStructure::ProcessData(DataDescription *dataDescription)
 	}
 
 	transformArray = &dataStructure->GetDataElement(0);
+	matrixData = transformArray;
 	return (kDataOkay);
 }
 
+void TransformStructure::CalculateMatrix(const float *data, float *matrix) const
+{
+	for (machine a = 0; a < 16; a++)
+	{
+		matrix[a] = data[a];
+	}
+}
+
 
 TranslationStructure::TranslationStructure() :
 		MatrixStructure(kStructureTranslation),
@@ -470,7 +631,7 @@ bool TranslationStructure::ValidateProperty(const DataDescription *dataDescripti
 		return (true);
 	}
 
-	return (false);
+	return (MatrixStructure::ValidateProperty(dataDescription, identifier, type, value));
 }
 
 bool TranslationStructure::ValidateSubstructure(const DataDescription *dataDescription, const Structure *structure) const
@@ -520,14 +681,36 @@ DataResult TranslationStructure::ProcessData(DataDescription *dataDescription)
 		return (kDataOpenGexInvalidTranslationKind);
 	}
 
-	const float *data = &dataStructure->GetDataElement(0);
-
 	// Data is 1 or 3 floats depending on kind.
-	// Build application-specific transform here.
+	matrixData = &dataStructure->GetDataElement(0);
 
 	return (kDataOkay);
 }
 
+void TranslationStructure::CalculateMatrix(const float *data, float *matrix) const
+{
+	SetIdentityMatrix(matrix);
+
+	if (translationKind == "x")
+	{
+		matrix[12] = data[0];
+	}
+	else if (translationKind == "y")
+	{
+		matrix[13] = data[0];
+	}
+	else if (translationKind == "z")
+	{
+		matrix[14] = data[0];
+	}
+	else
+	{
+		matrix[12] = data[0];
+		matrix[13] = data[1];
+		matrix[14] = data[2];
+	}
+}
+
 
 RotationStructure::RotationStructure() :
 		MatrixStructure(kStructureRotation),
@@ -548,7 +731,7 @@ bool RotationStructure::ValidateProperty(const DataDescription *dataDescription,
 		return (true);
 	}
 
-	return (false);
+	return (MatrixStructure::ValidateProperty(dataDescription, identifier, type, value));
 }
 
 bool RotationStructure::ValidateSubstructure(const DataDescription *dataDescription, const Structure *structure) const
@@ -598,14 +781,82 @@ DataResult RotationStructure::ProcessData(DataDescription *dataDescription)
 		return (kDataOpenGexInvalidRotationKind);
 	}
 
-	const float *data = &dataStructure->GetDataElement(0);
-
 	// Data is 1 or 4 floats depending on kind.
-	// Build application-specific transform here.
+	matrixData = &dataStructure->GetDataElement(0);
 
 	return (kDataOkay);
 }
 
+void RotationStructure::CalculateMatrix(const float *data, float *matrix) const
+{
+	SetIdentityMatrix(matrix);
+
+	if ((rotationKind == "x") || (rotationKind == "y") || (rotationKind == "z"))
+	{
+		float c = cosf(data[0]);
+		float s = sinf(data[0]);
+
+		// Indices of the two axes spanning the plane of rotation, in right-handed order.
+		int32 i = (rotationKind == "x") ? 1 : ((rotationKind == "y") ? 2 : 0);
+		int32 j = (i + 1) % 3;
+
+		matrix[i * 4 + i] = c;
+		matrix[i * 4 + j] = s;
+		matrix[j * 4 + i] = -s;
+		matrix[j * 4 + j] = c;
+	}
+	else if (rotationKind == "axis")
+	{
+		float x = data[1];
+		float y = data[2];
+		float z = data[3];
+
+		float length = sqrtf(x * x + y * y + z * z);
+		if (length > 0.0F)
+		{
+			x /= length;
+			y /= length;
+			z /= length;
+		}
+
+		float c = cosf(data[0]);
+		float s = sinf(data[0]);
+		float d = 1.0F - c;
+
+		matrix[0] = c + d * x * x;
+		matrix[1] = d * x * y + s * z;
+		matrix[2] = d * x * z - s * y;
+		matrix[4] = d * x * y - s * z;
+		matrix[5] = c + d * y * y;
+		matrix[6] = d * y * z + s * x;
+		matrix[8] = d * x * z + s * y;
+		matrix[9] = d * y * z - s * x;
+		matrix[10] = c + d * z * z;
+	}
+	else
+	{
+		// Interpolated quaternions are generally not unit length, so they are normalized here.
+
+		float x = data[0];
+		float y = data[1];
+		float z = data[2];
+		float w = data[3];
+
+		float length = x * x + y * y + z * z + w * w;
+		float f = (length > 0.0F) ? 2.0F / length : 0.0F;
+
+		matrix[0] = 1.0F - f * (y * y + z * z);
+		matrix[1] = f * (x * y + w * z);
+		matrix[2] = f * (x * z - w * y);
+		matrix[4] = f * (x * y - w * z);
+		matrix[5] = 1.0F - f * (x * x + z * z);
+		matrix[6] = f * (y * z + w * x);
+		matrix[8] = f * (x * z + w * y);
+		matrix[9] = f * (y * z - w * x);
+		matrix[10] = 1.0F - f * (x * x + y * y);
+	}
+}
+
 
 ScaleStructure::ScaleStructure() :
 		MatrixStructure(kStructureScale),
@@ -626,7 +877,7 @@ bool ScaleStructure::ValidateProperty(const DataDescription *dataDescription, co
 		return (true);
 	}
 
-	return (false);
+	return (MatrixStructure::ValidateProperty(dataDescription, identifier, type, value));
 }
 
 bool ScaleStructure::ValidateSubstructure(const DataDescription *dataDescription, const Structure *structure) const
@@ -676,14 +927,36 @@ DataResult ScaleStructure::ProcessData(DataDescription *dataDescription)
 		return (kDataOpenGexInvalidScaleKind);
 	}
 
-	const float *data = &dataStructure->GetDataElement(0);
-
 	// Data is 1 or 3 floats depending on kind.
-	// Build application-specific transform here.
+	matrixData = &dataStructure->GetDataElement(0);
 
 	return (kDataOkay);
 }
 
+void ScaleStructure::CalculateMatrix(const float *data, float *matrix) const
+{
+	SetIdentityMatrix(matrix);
+
+	if (scaleKind == "x")
+	{
+		matrix[0] = data[0];
+	}
+	else if (scaleKind == "y")
+	{
+		matrix[5] = data[0];
+	}
+	else if (scaleKind == "z")
+	{
+		matrix[10] = data[0];
+	}
+	else
+	{
+		matrix[0] = data[0];
+		matrix[5] = data[1];
+		matrix[10] = data[2];
+	}
+}
+
 
 MorphWeightStructure::MorphWeightStructure() : AnimatableStructure(kStructureMorphWeight)
 {
@@ -751,11 +1024,31 @@ DataResult MorphWeightStructure::ProcessData(DataDescription *dataDescription)
 NodeStructure::NodeStructure() : OpenGexStructure(kStructureNode)
 {
 	SetBaseStructureType(kStructureNode);
+
+	SetIdentityMatrix(nodeTransform);
+	SetIdentityMatrix(objectTransform);
+	SetIdentityMatrix(globalTransform);
+
+	boundsFlag = false;
+	for (machine a = 0; a < 3; a++)
+	{
+		boundsMin[a] = boundsMax[a] = 0.0F;
+	}
 }
 
 NodeStructure::NodeStructure(StructureType type) : OpenGexStructure(type)
 {
 	SetBaseStructureType(kStructureNode);
+
+	SetIdentityMatrix(nodeTransform);
+	SetIdentityMatrix(objectTransform);
+	SetIdentityMatrix(globalTransform);
+
+	boundsFlag = false;
+	for (machine a = 0; a < 3; a++)
+	{
+		boundsMin[a] = boundsMax[a] = 0.0F;
+	}
 }
 
 NodeStructure::~NodeStructure()
@@ -812,6 +1105,118 @@ const ObjectStructure *NodeStructure::GetObjectStructure(void) const
 	return (nullptr);
 }
 
+void NodeStructure::CalculateTransforms(const OpenGexDataDescription *dataDescription)
+{
+	float matrix[16];
+	float product[16];
+
+	SetIdentityMatrix(nodeTransform);
+	SetIdentityMatrix(objectTransform);
+
+	// The matrices are multiplied in the order they appear, so the last one is applied to vertices first.
+
+	const Structure *structure = GetFirstSubnode();
+	while (structure)
+	{
+		if (structure->GetBaseStructureType() == kStructureMatrix)
+		{
+			const MatrixStructure *matrixStructure = static_cast<const MatrixStructure *>(structure);
+			matrixStructure->CalculateMatrix(matrixStructure->GetMatrixData(), matrix);
+
+			float *transform = (matrixStructure->GetObjectFlag()) ? objectTransform : nodeTransform;
+			MultiplyMatrix(transform, matrix, product);
+			for (machine a = 0; a < 16; a++)
+			{
+				transform[a] = product[a];
+			}
+		}
+
+		structure = structure->Next();
+	}
+
+	const Structure *superNode = GetSuperNode();
+	if ((superNode) && (superNode->GetBaseStructureType() == kStructureNode))
+	{
+		MultiplyMatrix(static_cast<const NodeStructure *>(superNode)->globalTransform, nodeTransform, globalTransform);
+	}
+	else
+	{
+		for (machine a = 0; a < 16; a++)
+		{
+			globalTransform[a] = nodeTransform[a];
+		}
+	}
+}
+
+void NodeStructure::CalculateBounds(void)
+{
+	float minimum[3];
+	float maximum[3];
+
+	boundsFlag = false;
+
+	if (GetStructureType() == kStructureGeometryNode)
+	{
+		GeometryObjectStructure *geometryObjectStructure = static_cast<const GeometryNodeStructure *>(this)->geometryObjectStructure;
+		if (geometryObjectStructure)
+		{
+			float transform[16];
+			MultiplyMatrix(globalTransform, objectTransform, transform);
+
+			// Every level of detail is included, since any of them may be the one that gets drawn.
+
+			const MeshStructure *meshStructure = geometryObjectStructure->GetMeshMap()->First();
+			while (meshStructure)
+			{
+				const VertexArrayStructure *vertexArrayStructure = meshStructure->GetVertexArray(kVertexAttribPosition);
+				if (vertexArrayStructure)
+				{
+					TransformBounds(transform, vertexArrayStructure->GetBoundsMin(), vertexArrayStructure->GetBoundsMax(), minimum, maximum);
+					IncludeBounds(minimum, maximum);
+				}
+
+				meshStructure = meshStructure->Next();
+			}
+		}
+	}
+
+	const Structure *structure = GetFirstSubnode();
+	while (structure)
+	{
+		if (structure->GetBaseStructureType() == kStructureNode)
+		{
+			const NodeStructure *nodeStructure = static_cast<const NodeStructure *>(structure);
+			if (nodeStructure->boundsFlag)
+			{
+				IncludeBounds(nodeStructure->boundsMin, nodeStructure->boundsMax);
+			}
+		}
+
+		structure = structure->Next();
+	}
+}
+
+void NodeStructure::IncludeBounds(const float *minimum, const float *maximum)
+{
+	if (!boundsFlag)
+	{
+		for (machine a = 0; a < 3; a++)
+		{
+			boundsMin[a] = minimum[a];
+			boundsMax[a] = maximum[a];
+		}
+
+		boundsFlag = true;
+		return;
+	}
+
+	for (machine a = 0; a < 3; a++)
+	{
+		boundsMin[a] = (minimum[a] < boundsMin[a]) ? minimum[a] : boundsMin[a];
+		boundsMax[a] = (maximum[a] > boundsMax[a]) ? maximum[a] : boundsMax[a];
+	}
+}
+
 
 BoneNodeStructure::BoneNodeStructure() : NodeStructure(kStructureBoneNode)
 {
@@ -1131,7 +1536,14 @@ const ObjectStructure *CameraNodeStructure::GetObjectStructure(void) const
 VertexArrayStructure::VertexArrayStructure() : OpenGexStructure(kStructureVertexArray)
 {
 	morphIndex = 0;
+	attribType = kVertexAttribUnknown;
+	attribIndex = 0;
 	dataStructure = nullptr;
+
+	for (machine a = 0; a < 3; a++)
+	{
+		boundsMin[a] = boundsMax[a] = 0.0F;
+	}
 }
 
 VertexArrayStructure::~VertexArrayStructure()
@@ -1182,21 +1594,75 @@ DataResult VertexArrayStructure::ProcessData(DataDescription *dataDescription)
 	
 	dataStructure = static_cast<DataStructure<FloatDataType> *>(structure);
 
+	ClassifyArrayAttrib();
+
 	int32 arraySize = dataStructure->GetArraySize();
 	int32 elementCount = dataStructure->GetDataElementCount();
-	int32 vertexCount = elementCount / arraySize;
-	const float *data = &dataStructure->GetDataElement(0);
+	int32 vertexCount = (arraySize > 0) ? elementCount / arraySize : 0;
 
-	// Do something with the vertex data here.
+	if ((attribType == kVertexAttribPosition) && (vertexCount > 0))
+	{
+		CalculatePointBounds(vertexCount, arraySize, &dataStructure->GetDataElement(0), boundsMin, boundsMax);
+	}
 
 	return (kDataOkay);
 }
 
 
+void VertexArrayStructure::ClassifyArrayAttrib(void)
+{
+	static const char *const attribName[kVertexAttribCount] =
+	{
+		"position", "normal", "tangent", "bitangent", "color", "texcoord"
+	};
+
+	// The attrib string is a name optionally followed by a subscript, as in "texcoord[1]".
+
+	const char *text = arrayAttrib;
+	int32 nameLength = 0;
+	while ((text[nameLength] != 0) && (text[nameLength] != '['))
+	{
+		nameLength++;
+	}
+
+	unsigned_int32 index = 0;
+	if (text[nameLength] == '[')
+	{
+		const char *digit = text + nameLength + 1;
+		while ((*digit >= '0') && (*digit <= '9'))
+		{
+			index = index * 10 + (*digit - '0');
+			digit++;
+		}
+
+		if ((*digit != ']') || (digit[1] != 0))
+		{
+			return;
+		}
+	}
+
+	if (index >= kMaxVertexAttribIndex)
+	{
+		return;
+	}
+
+	for (machine a = 0; a < kVertexAttribCount; a++)
+	{
+		if ((Text::GetTextLength(attribName[a]) == nameLength) && (Text::CompareText(text, attribName[a], nameLength)))
+		{
+			attribType = (unsigned_int32) a;
+			attribIndex = index;
+			return;
+		}
+	}
+}
+
+
 IndexArrayStructure::IndexArrayStructure() : OpenGexStructure(kStructureIndexArray)
 {
 	materialIndex = 0;
 	restartIndex = 0;
+	restartFlag = false;
 	primitiveStructure = nullptr;
 	frontFace = "ccw";
 }
@@ -1218,6 +1684,7 @@ bool IndexArrayStructure::ValidateProperty(const DataDescription *dataDescriptio
 	{
 		*type = kDataUnsignedInt64;
 		*value = &restartIndex;
+		restartFlag = true;
 		return (true);
 	}
 
@@ -1255,8 +1722,12 @@ DataResult IndexArrayStructure::ProcessData(DataDescription *dataDescription)
 		return (kDataExtraneousSubstructure);
 	}
 
+	// Triangle lists use subarrays of 3, quads of 4 and strips are flat. The owning mesh
+	// checks this against its primitive type and expands everything to triangle lists.
+
 	primitiveStructure = static_cast<PrimitiveStructure *>(structure);
-	if (primitiveStructure->GetArraySize() != 3)
+	unsigned_int32 arraySize = primitiveStructure->GetArraySize();
+	if ((arraySize != 0) && (arraySize != 3) && (arraySize != 4))
 	{
 		return (kDataInvalidDataFormat);
 	}
@@ -1306,9 +1777,124 @@ DataResult IndexArrayStructure::ProcessData(DataDescription *dataDescription)
 	}
 	// Do something with the index array here.
 
+	SetAccountedPayload(kMemoryIndexArray, indicesArray.GetElementCount() * sizeof(unsigned_int32));
 	return (kDataOkay);
 }
 
+DataResult IndexArrayStructure::ExpandPrimitives(const String& primitive)
+{
+	unsigned_int32 arraySize = primitiveStructure->GetArraySize();
+
+	if (primitive == "triangles")
+	{
+		if (arraySize != 3)
+		{
+			return (kDataInvalidDataFormat);
+		}
+
+		return (kDataOkay);
+	}
+
+	if (primitive == "quads")
+	{
+		if (arraySize != 4)
+		{
+			return (kDataInvalidDataFormat);
+		}
+
+		ExpandQuads();
+		SetAccountedPayload(kMemoryIndexArray, indicesArray.GetElementCount() * sizeof(unsigned_int32));
+		return (kDataOkay);
+	}
+
+	if (primitive == "triangle_strip")
+	{
+		if (arraySize != 0)
+		{
+			return (kDataInvalidDataFormat);
+		}
+
+		ExpandTriangleStrip();
+		SetAccountedPayload(kMemoryIndexArray, indicesArray.GetElementCount() * sizeof(unsigned_int32));
+		return (kDataOkay);
+	}
+
+	return (kDataOpenGexPrimitiveUnsupported);
+}
+
+void IndexArrayStructure::ExpandQuads(void)
+{
+	Array<unsigned_int32> quadArray(static_cast<Array<unsigned_int32>&&>(indicesArray));
+
+	int32 quadCount = quadArray.GetElementCount() / 4;
+	indicesArray.Reserve(quadCount * 6);
+
+	for (machine a = 0; a < quadCount; a++)
+	{
+		const unsigned_int32 *quad = &quadArray[a * 4];
+
+		indicesArray.AddElement(quad[0]);
+		indicesArray.AddElement(quad[1]);
+		indicesArray.AddElement(quad[2]);
+
+		indicesArray.AddElement(quad[0]);
+		indicesArray.AddElement(quad[2]);
+		indicesArray.AddElement(quad[3]);
+	}
+
+	// The quads are only released when this returns, so both arrays count toward the peak.
+	SetAccountedPayload(kMemoryIndexArray, (quadArray.GetElementCount() + indicesArray.GetElementCount()) * sizeof(unsigned_int32));
+}
+
+void IndexArrayStructure::ExpandTriangleStrip(void)
+{
+	Array<unsigned_int32> stripArray(static_cast<Array<unsigned_int32>&&>(indicesArray));
+
+	int32 indexCount = stripArray.GetElementCount();
+	indicesArray.Reserve(Max(indexCount - 2, 0) * 3);
+
+	// Every other triangle of a strip has its winding reversed. The parity restarts together with the strip,
+	// and degenerate triangles that only serve to stitch strips together are dropped.
+
+	int32 stripStart = 0;
+	while (stripStart < indexCount)
+	{
+		int32 stripEnd = stripStart;
+		while ((stripEnd < indexCount) && ((!restartFlag) || (stripArray[stripEnd] != restartIndex)))
+		{
+			stripEnd++;
+		}
+
+		for (machine a = stripStart; a + 2 < stripEnd; a++)
+		{
+			unsigned_int32 i0 = stripArray[a];
+			unsigned_int32 i1 = stripArray[a + 1];
+			unsigned_int32 i2 = stripArray[a + 2];
+
+			if ((i0 == i1) || (i1 == i2) || (i2 == i0))
+			{
+				continue;
+			}
+
+			if (((a - stripStart) & 1) != 0)
+			{
+				unsigned_int32 t = i0;
+				i0 = i1;
+				i1 = t;
+			}
+
+			indicesArray.AddElement(i0);
+			indicesArray.AddElement(i1);
+			indicesArray.AddElement(i2);
+		}
+
+		stripStart = stripEnd + 1;
+	}
+
+	// The strip is only released when this returns, so both arrays count toward the peak.
+	SetAccountedPayload(kMemoryIndexArray, (stripArray.GetElementCount() + indicesArray.GetElementCount()) * sizeof(unsigned_int32));
+}
+
 
 BoneRefArrayStructure::BoneRefArrayStructure() : OpenGexStructure(kStructureBoneRefArray)
 {
@@ -1349,6 +1935,7 @@ DataResult BoneRefArrayStructure::ProcessData(DataDescription *dataDescription)
 	if (boneCount != 0)
 	{
 		boneNodeArray = new const BoneNodeStructure *[boneCount];
+		SetAccountedPayload(kMemoryBoneArray, boneCount * sizeof(const BoneNodeStructure *));
 
 		for (machine a = 0; a < boneCount; a++)
 		{
@@ -1476,6 +2063,11 @@ DataResult BoneCountArrayStructure::ProcessData(DataDescription *dataDescription
 		}
 	}
 
+	if (arrayStorage)
+	{
+		SetAccountedPayload(kMemoryBoneArray, vertexCount * sizeof(unsigned_int16));
+	}
+
 	return (kDataOkay);
 }
 
@@ -1584,6 +2176,11 @@ DataResult BoneIndexArrayStructure::ProcessData(DataDescription *dataDescription
 		}
 	}
 
+	if (arrayStorage)
+	{
+		SetAccountedPayload(kMemoryBoneArray, boneIndexCount * sizeof(unsigned_int16));
+	}
+
 	return (kDataOkay);
 }
 
@@ -1695,10 +2292,93 @@ DataResult SkeletonStructure::ProcessData(DataDescription *dataDescription)
 
 SkinStructure::SkinStructure() : OpenGexStructure(kStructureSkin)
 {
+	influenceOffsetArray = nullptr;
+	transformStructure = nullptr;
+	skeletonStructure = nullptr;
+	boneCountArrayStructure = nullptr;
+	boneIndexArrayStructure = nullptr;
+	boneWeightArrayStructure = nullptr;
 }
 
 SkinStructure::~SkinStructure()
 {
+	delete[] influenceOffsetArray;
+}
+
+void SkinStructure::SumInfluenceCountBlock(int32 jobIndex, void *cookie)
+{
+	const InfluenceOffsetJob *job = static_cast<const InfluenceOffsetJob *>(cookie);
+
+	int32 start = jobIndex * kInfluenceOffsetBlockSize;
+	int32 end = Min(start + kInfluenceOffsetBlockSize, job->vertexCount);
+
+	int32 sum = 0;
+	for (machine a = start; a < end; a++)
+	{
+		sum += job->boneCountArray[a];
+	}
+
+	job->blockSumArray[jobIndex] = sum;
+}
+
+void SkinStructure::WriteInfluenceOffsetBlock(int32 jobIndex, void *cookie)
+{
+	const InfluenceOffsetJob *job = static_cast<const InfluenceOffsetJob *>(cookie);
+
+	int32 start = jobIndex * kInfluenceOffsetBlockSize;
+	int32 end = Min(start + kInfluenceOffsetBlockSize, job->vertexCount);
+
+	// The block sums have been turned into the offset of each block's first vertex by now.
+	int32 offset = job->blockSumArray[jobIndex];
+	for (machine a = start; a < end; a++)
+	{
+		job->influenceOffsetArray[a] = offset;
+		offset += job->boneCountArray[a];
+	}
+}
+
+int32 SkinStructure::CalculateInfluenceOffsets(DataDescription *dataDescription, const unsigned_int16 *boneCountArray, int32 vertexCount)
+{
+	// Builds the exclusive prefix sum of the bone counts so that the influences of any vertex can be found
+	// directly. Large skins are split into blocks that are summed in parallel, then the block sums are scanned,
+	// and finally each block writes its offsets in parallel starting from its own base.
+
+	delete[] influenceOffsetArray;
+	influenceOffsetArray = new int32[vertexCount + 1];
+	SetAccountedPayload(kMemoryBoneArray, (vertexCount + 1) * sizeof(int32));
+
+	int32 blockCount = (vertexCount + kInfluenceOffsetBlockSize - 1) / kInfluenceOffsetBlockSize;
+	if (blockCount <= 1)
+	{
+		int32 offset = 0;
+		for (machine a = 0; a < vertexCount; a++)
+		{
+			influenceOffsetArray[a] = offset;
+			offset += boneCountArray[a];
+		}
+
+		influenceOffsetArray[vertexCount] = offset;
+		return (offset);
+	}
+
+	Array<int32> blockSumArray(blockCount);
+	blockSumArray.SetElementCount(blockCount);
+
+	InfluenceOffsetJob job = {boneCountArray, vertexCount, influenceOffsetArray, &blockSumArray[0]};
+	dataDescription->RunParallelJobs(blockCount, &SumInfluenceCountBlock, &job);
+
+	int32 offset = 0;
+	for (machine a = 0; a < blockCount; a++)
+	{
+		int32 sum = blockSumArray[a];
+		blockSumArray[a] = offset;
+		offset += sum;
+	}
+
+	dataDescription->RunParallelJobs(blockCount, &WriteInfluenceOffsetBlock, &job);
+
+	influenceOffsetArray[vertexCount] = offset;
+	return (offset);
 }
 
 bool SkinStructure::ValidateSubstructure(const DataDescription *dataDescription, const Structure *structure) const
@@ -1728,7 +2408,7 @@ DataResult SkinStructure::ProcessData(DataDescription *dataDescription)
 			return (kDataExtraneousSubstructure);
 		}
 
-		// Process skin transform here.
+		transformStructure = static_cast<const TransformStructure *>(structure);
 	}
 
 	structure = GetFirstSubstructure(kStructureSkeleton);
@@ -1790,15 +2470,7 @@ DataResult SkinStructure::ProcessData(DataDescription *dataDescription)
 	}
 
 	int32 vertexCount = boneCountArrayStructure->GetVertexCount();
-	const unsigned_int16 *boneCountArray = boneCountArrayStructure->GetBoneCountArray();
-
-	int32 boneWeightCount = 0;
-	for (machine a = 0; a < vertexCount; a++)
-	{
-		unsigned_int32 count = boneCountArray[a];
-		boneWeightCount += count;
-	}
-
+	int32 boneWeightCount = CalculateInfluenceOffsets(dataDescription, boneCountArrayStructure->GetBoneCountArray(), vertexCount);
 	if (boneWeightCount != boneIndexCount)
 	{
 		return (kDataOpenGexBoneWeightCountMismatch);
@@ -1885,6 +2557,15 @@ DataResult MorphStructure::ProcessData(DataDescription *dataDescription)
 MeshStructure::MeshStructure() : OpenGexStructure(kStructureMesh)
 {
 	meshLevel = 0;
+	meshPrimitive = "triangles";
+
+	for (machine a = 0; a < kVertexAttribCount; a++)
+	{
+		for (machine b = 0; b < kMaxVertexAttribIndex; b++)
+		{
+			vertexAttribTable[a][b] = nullptr;
+		}
+	}
 
 	skinStructure = nullptr;
 }
@@ -1893,6 +2574,26 @@ MeshStructure::~MeshStructure()
 {
 }
 
+VertexArrayStructure *MeshStructure::GetMorphVertexArray(unsigned_int32 attrib, unsigned_int32 morphIndex) const
+{
+	if (morphIndex == 0)
+	{
+		return (vertexAttribTable[attrib][0]);
+	}
+
+	int32 count = vertexArrayStructures.GetElementCount();
+	for (machine a = 0; a < count; a++)
+	{
+		VertexArrayStructure *vertexArrayStructure = vertexArrayStructures[a];
+		if ((vertexArrayStructure->GetAttribType() == attrib) && (vertexArrayStructure->GetAttribIndex() == 0) && (vertexArrayStructure->GetMorphIndex() == morphIndex))
+		{
+			return (vertexArrayStructure);
+		}
+	}
+
+	return (nullptr);
+}
+
 bool MeshStructure::ValidateProperty(const DataDescription *dataDescription, const String& identifier, DataType *type, void **value)
 {
 	if (identifier == "lod")
@@ -1940,14 +2641,28 @@ DataResult MeshStructure::ProcessData(DataDescription *dataDescription)
 			VertexArrayStructure *vertexArrayStructure = static_cast<VertexArrayStructure *>(structure);
 			vertexArrayStructures.AddElement(vertexArrayStructure);
 
-			// Process vertex array here.
+			unsigned_int32 attrib = vertexArrayStructure->GetAttribType();
+			if ((attrib != kVertexAttribUnknown) && (vertexArrayStructure->GetMorphIndex() == 0))
+			{
+				VertexArrayStructure *&entry = vertexAttribTable[attrib][vertexArrayStructure->GetAttribIndex()];
+				if (entry)
+				{
+					return (kDataOpenGexDuplicateVertexArray);
+				}
+
+				entry = vertexArrayStructure;
+			}
 		}
 		else if (type == kStructureIndexArray)
 		{
 			IndexArrayStructure *indexArrayStructure = static_cast<IndexArrayStructure *>(structure);
 			indexArrayStructures.AddElement(indexArrayStructure);
 
-			// Process index array here.
+			result = indexArrayStructure->ExpandPrimitives(meshPrimitive);
+			if (result != kDataOkay)
+			{
+				return (result);
+			}
 		}
 		else if (type == kStructureSkin)
 		{
@@ -1962,6 +2677,11 @@ DataResult MeshStructure::ProcessData(DataDescription *dataDescription)
 		structure = structure->Next();
 	}
 
+	if (!vertexAttribTable[kVertexAttribPosition][0])
+	{
+		return (kDataOpenGexPositionArrayRequired);
+	}
+
 	// Do application-specific mesh processing here.
 
 	return (kDataOkay);
@@ -2744,6 +3464,7 @@ KeyStructure::KeyStructure() :
 		OpenGexStructure(kStructureKey),
 		keyKind("value")
 {
+	keyData = nullptr;
 }
 
 KeyStructure::~KeyStructure()
@@ -2797,6 +3518,8 @@ DataResult KeyStructure::ProcessData(DataDescription *dataDescription)
 		return (kDataOpenGexEmptyKeyStructure);
 	}
 
+	keyData = &dataStructure->GetDataElement(0);
+
 	if ((keyKind == "value") || (keyKind == "-control") || (keyKind == "+control"))
 	{
 		scalarFlag = false;
@@ -3052,6 +3775,7 @@ DataResult TimeStructure::ProcessData(DataDescription *dataDescription)
 
 ValueStructure::ValueStructure() : CurveStructure(kStructureValue)
 {
+	valueSize = 0;
 }
 
 ValueStructure::~ValueStructure()
@@ -3079,6 +3803,8 @@ DataResult ValueStructure::ProcessData(DataDescription *dataDescription)
 		unsigned_int32 targetArraySize = static_cast<const PrimitiveStructure *>(targetDataStructure)->GetArraySize();
 		int32 elementCount = 0;
 
+		valueSize = Max(targetArraySize, 1);
+
 		const Structure *structure = GetFirstSubnode();
 		while (structure)
 		{
@@ -3123,6 +3849,166 @@ TrackStructure::~TrackStructure()
 {
 }
 
+void TrackStructure::EvaluateTrack(int32 timeCount, const float *timeArray, float *result) const
+{
+	int32 keyCount = GetKeyCount();
+	int32 valueSize = valueStructure->GetValueSize();
+
+	const float *timeKey = timeStructure->GetKeyValueStructure()->GetKeyData();
+	const float *valueKey = valueStructure->GetKeyValueStructure()->GetKeyData();
+
+	if (keyCount == 1)
+	{
+		for (machine a = 0; a < timeCount; a++)
+		{
+			for (machine k = 0; k < valueSize; k++)
+			{
+				result[a * valueSize + k] = valueKey[k];
+			}
+		}
+
+		return;
+	}
+
+	bool bezierTime = (timeStructure->GetCurveType() == "bezier");
+	const String& curveType = valueStructure->GetCurveType();
+
+	// Each segment is converted once to the power basis ((a * s + b) * s + c) * s + d, so every
+	// sample costs the same branch-free polynomial regardless of the curve type. A value has at
+	// most 16 components, and the coefficients of component k are stored at 4 * k.
+
+	float coefficient[64];
+	int32 index = -1;
+
+	for (machine a = 0; a < timeCount; a++)
+	{
+		float time = timeArray[a];
+
+		// Find the segment with timeKey[segment] <= time < timeKey[segment + 1], clamping times outside the keys.
+
+		int32 segment;
+		if ((index >= 0) && (time >= timeKey[index]) && (time < timeKey[index + 1]))
+		{
+			segment = index;
+		}
+		else if (time < timeKey[1])
+		{
+			segment = 0;
+		}
+		else if (time >= timeKey[keyCount - 2])
+		{
+			segment = keyCount - 2;
+		}
+		else
+		{
+			segment = 1;
+			int32 last = keyCount - 2;
+			while (last - segment > 1)
+			{
+				int32 middle = (segment + last) >> 1;
+				if (timeKey[middle] <= time)
+				{
+					segment = middle;
+				}
+				else
+				{
+					last = middle;
+				}
+			}
+		}
+
+		float t0 = timeKey[segment];
+		float t1 = timeKey[segment + 1];
+
+		if (segment != index)
+		{
+			index = segment;
+
+			const float *v1 = valueKey + index * valueSize;
+			const float *v2 = v1 + valueSize;
+
+			if (curveType == "bezier")
+			{
+				const float *c1 = valueStructure->GetKeyControlStructure(1)->GetKeyData() + index * valueSize;
+				const float *c2 = valueStructure->GetKeyControlStructure(0)->GetKeyData() + (index + 1) * valueSize;
+
+				for (machine k = 0; k < valueSize; k++)
+				{
+					float *c = &coefficient[k * 4];
+					c[0] = v2[k] - v1[k] + 3.0F * (c1[k] - c2[k]);
+					c[1] = 3.0F * (v1[k] - 2.0F * c1[k] + c2[k]);
+					c[2] = 3.0F * (c1[k] - v1[k]);
+					c[3] = v1[k];
+				}
+			}
+			else if (curveType == "tcb")
+			{
+				// Kochanek-Bartels tangents, with the end keys repeated where a neighbor is missing.
+
+				const float *v0 = (index > 0) ? v1 - valueSize : v1;
+				const float *v3 = (index + 2 < keyCount) ? v2 + valueSize : v2;
+
+				const float *tension = valueStructure->GetKeyTensionStructure()->GetKeyData();
+				const float *continuity = valueStructure->GetKeyContinuityStructure()->GetKeyData();
+				const float *bias = valueStructure->GetKeyBiasStructure()->GetKeyData();
+
+				float a1 = (1.0F - tension[index]) * (1.0F + continuity[index]) * (1.0F + bias[index]) * 0.5F;
+				float b1 = (1.0F - tension[index]) * (1.0F - continuity[index]) * (1.0F - bias[index]) * 0.5F;
+				float a2 = (1.0F - tension[index + 1]) * (1.0F - continuity[index + 1]) * (1.0F + bias[index + 1]) * 0.5F;
+				float b2 = (1.0F - tension[index + 1]) * (1.0F + continuity[index + 1]) * (1.0F - bias[index + 1]) * 0.5F;
+
+				for (machine k = 0; k < valueSize; k++)
+				{
+					float d1 = a1 * (v1[k] - v0[k]) + b1 * (v2[k] - v1[k]);
+					float d2 = a2 * (v2[k] - v1[k]) + b2 * (v3[k] - v2[k]);
+
+					float *c = &coefficient[k * 4];
+					c[0] = 2.0F * (v1[k] - v2[k]) + d1 + d2;
+					c[1] = 3.0F * (v2[k] - v1[k]) - 2.0F * d1 - d2;
+					c[2] = d1;
+					c[3] = v1[k];
+				}
+			}
+			else
+			{
+				for (machine k = 0; k < valueSize; k++)
+				{
+					float *c = &coefficient[k * 4];
+					c[0] = 0.0F;
+					c[1] = 0.0F;
+					c[2] = v2[k] - v1[k];
+					c[3] = v1[k];
+				}
+			}
+		}
+
+		float s;
+		if (time <= t0)
+		{
+			s = 0.0F;
+		}
+		else if (time >= t1)
+		{
+			s = 1.0F;
+		}
+		else if (bezierTime)
+		{
+			s = SolveBezierTime(t0, timeStructure->GetKeyControlStructure(1)->GetKeyData()[index], timeStructure->GetKeyControlStructure(0)->GetKeyData()[index + 1], t1, time);
+		}
+		else
+		{
+			s = (time - t0) / (t1 - t0);
+		}
+
+		float *value = result + a * valueSize;
+		for (machine k = 0; k < valueSize; k++)
+		{
+			const float *c = &coefficient[k * 4];
+			value[k] = ((c[0] * s + c[1]) * s + c[2]) * s + c[3];
+		}
+	}
+}
+
 bool TrackStructure::ValidateProperty(const DataDescription *dataDescription, const String& identifier, DataType *type, void **value)
 {
 	if (identifier == "target")
@@ -3606,6 +4492,48 @@ Structure *OpenGexDataDescription::CreateStructure(const String& identifier) con
 	return (nullptr);
 }
 
+void OpenGexDataDescription::EvaluateTrackJob(int32 jobIndex, void *cookie)
+{
+	const TrackEvaluationJob *job = static_cast<const TrackEvaluationJob *>(cookie);
+	job->trackArray[jobIndex]->EvaluateTrack(job->timeCount, job->timeArray, job->resultArray[jobIndex]);
+}
+
+void OpenGexDataDescription::CalculateSubtreeTransformsJob(int32 jobIndex, void *cookie)
+{
+	const OpenGexDataDescription *dataDescription = static_cast<const OpenGexDataDescription *>(cookie);
+
+	// Walk the subtree depth first, so every super node is done before its subnodes.
+
+	Array<NodeStructure *> nodeArray;
+
+	Structure *root = dataDescription->rootNodeArray[jobIndex];
+	Structure *structure = root;
+	while (structure)
+	{
+		if (structure->GetBaseStructureType() == kStructureNode)
+		{
+			NodeStructure *nodeStructure = static_cast<NodeStructure *>(structure);
+			nodeStructure->CalculateTransforms(dataDescription);
+			nodeArray.AddElement(nodeStructure);
+		}
+
+		structure = root->GetNextNode(structure);
+	}
+
+	// Bounds go the other way, so visiting the nodes in reverse order finishes every subnode before its super node.
+
+	for (machine a = nodeArray.GetElementCount() - 1; a >= 0; a--)
+	{
+		nodeArray[a]->CalculateBounds();
+	}
+}
+
+void OpenGexDataDescription::EvaluateTracks(int32 trackCount, const TrackStructure *const *trackArray, int32 timeCount, const float *timeArray, float *const *resultArray)
+{
+	TrackEvaluationJob job = {trackArray, timeCount, timeArray, resultArray};
+	RunParallelJobs(trackCount, &EvaluateTrackJob, &job);
+}
+
 bool OpenGexDataDescription::ValidateTopLevelStructure(const Structure *structure) const
 {
 	StructureType type = structure->GetBaseStructureType();
@@ -3623,13 +4551,22 @@ DataResult OpenGexDataDescription::ProcessData(void)
 	DataResult result = DataDescription::ProcessData();
 	if (result == kDataOkay)
 	{
+		rootNodeArray.Clear();
+
 		Structure *structure = GetRootStructure()->GetFirstSubnode();
 		while (structure)
 		{
-			// Do something with the node here.
+			if (structure->GetBaseStructureType() == kStructureNode)
+			{
+				rootNodeArray.AddElement(static_cast<NodeStructure *>(structure));
+			}
 
 			structure = structure->Next();
 		}
+
+		// Top-level node subtrees don't share any transforms, so each one is a separate job.
+
+		RunParallelJobs(rootNodeArray.GetElementCount(), &CalculateSubtreeTransformsJob, this);
 	}
 
 	return (result);
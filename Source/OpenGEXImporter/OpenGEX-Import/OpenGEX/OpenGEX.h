@@ -120,6 +120,7 @@ namespace OGEX
 		kDataOpenGexVertexCountUnsupported		= 'vcus',
 		kDataOpenGexIndexValueUnsupported		= 'ivus',
 		kDataOpenGexIndexArrayRequired			= 'iarq',
+		kDataOpenGexPrimitiveUnsupported		= 'prus',
 		kDataOpenGexVertexCountMismatch			= 'vcmm',
 		kDataOpenGexBoneCountMismatch			= 'bcmm',
 		kDataOpenGexBoneWeightCountMismatch		= 'bwcm',
@@ -138,6 +139,28 @@ namespace OGEX
 	};
 
 
+	// Vertex array attributes are classified once while parsing so that converters
+	// never have to look at the attrib strings.
+
+	enum
+	{
+		kVertexAttribPosition,
+		kVertexAttribNormal,
+		kVertexAttribTangent,
+		kVertexAttribBitangent,
+		kVertexAttribColor,
+		kVertexAttribTexcoord,
+		kVertexAttribCount,
+		kVertexAttribUnknown = kVertexAttribCount
+	};
+
+
+	enum
+	{
+		kMaxVertexAttribIndex					= 8
+	};
+
+
 	class MaterialStructure;
 	class ObjectStructure;
 	class GeometryObjectStructure;
@@ -272,6 +295,8 @@ namespace OGEX
 
 		protected:
 
+			const float		*matrixData;
+
 			MatrixStructure(StructureType type);
 
 		public:
@@ -283,6 +308,16 @@ namespace OGEX
 				return (objectFlag);
 			}
 
+			// Returns the float data of the structure, which is also the layout of the values of any track targeting it.
+			const float *GetMatrixData(void) const
+			{
+				return (matrixData);
+			}
+
+			// Builds the column-major 4x4 matrix the structure represents from data laid out like GetMatrixData(),
+			// so animated values sampled from a track can be turned into a matrix the same way as the static data.
+			virtual void CalculateMatrix(const float *data, float *matrix) const = 0;
+
 			bool ValidateProperty(const DataDescription *dataDescription, const String& identifier, DataType *type, void **value);
 	};
 
@@ -311,6 +346,8 @@ namespace OGEX
 
 			bool ValidateSubstructure(const DataDescription *dataDescription, const Structure *structure) const;
 			DataResult ProcessData(DataDescription *dataDescription);
+
+			void CalculateMatrix(const float *data, float *matrix) const;
 	};
 
 
@@ -333,6 +370,8 @@ namespace OGEX
 			bool ValidateProperty(const DataDescription *dataDescription, const String& identifier, DataType *type, void **value);
 			bool ValidateSubstructure(const DataDescription *dataDescription, const Structure *structure) const;
 			DataResult ProcessData(DataDescription *dataDescription);
+
+			void CalculateMatrix(const float *data, float *matrix) const;
 	};
 
 
@@ -355,6 +394,8 @@ namespace OGEX
 			bool ValidateProperty(const DataDescription *dataDescription, const String& identifier, DataType *type, void **value);
 			bool ValidateSubstructure(const DataDescription *dataDescription, const Structure *structure) const;
 			DataResult ProcessData(DataDescription *dataDescription);
+
+			void CalculateMatrix(const float *data, float *matrix) const;
 	};
 
 
@@ -377,6 +418,8 @@ namespace OGEX
 			bool ValidateProperty(const DataDescription *dataDescription, const String& identifier, DataType *type, void **value);
 			bool ValidateSubstructure(const DataDescription *dataDescription, const Structure *structure) const;
 			DataResult ProcessData(DataDescription *dataDescription);
+
+			void CalculateMatrix(const float *data, float *matrix) const;
 	};
 
 
@@ -410,14 +453,32 @@ namespace OGEX
 
 	class NodeStructure : public OpenGexStructure
 	{
+		private:
+
+			float			nodeTransform[16];
+			float			objectTransform[16];
+			float			globalTransform[16];
+
+			bool			boundsFlag;
+			float			boundsMin[3];
+			float			boundsMax[3];
+
+			void IncludeBounds(const float *minimum, const float *maximum);
+
 		public:
 
 			const char		*nodeName;
 
 			virtual const ObjectStructure *GetObjectStructure(void) const;
 
+			// Multiplies the node's matrix substructures into its transforms. The transforms of the super node,
+			// if it is a node, must have been calculated first.
 			void CalculateTransforms(const OpenGexDataDescription *dataDescription);
 
+			// Combines the bounds of the node's own geometry, placed by its global and object transforms, with the
+			// bounds of its subnodes. The bounds of all subnodes must have been calculated first.
+			void CalculateBounds(void);
+
 		protected:
 
 			NodeStructure(StructureType type);
@@ -432,6 +493,41 @@ namespace OGEX
 				return (nodeName);
 			}
 
+			// The product of the node's matrices that also apply to its subnodes, column-major.
+			const float *GetNodeTransform(void) const
+			{
+				return (nodeTransform);
+			}
+
+			// The product of the node's matrices flagged as object-only, applied after the node transform.
+			const float *GetObjectTransform(void) const
+			{
+				return (objectTransform);
+			}
+
+			// The node transform combined with the global transforms of all super nodes.
+			const float *GetGlobalTransform(void) const
+			{
+				return (globalTransform);
+			}
+
+			// Whether the node or any of its subnodes has geometry, in which case the bounds below enclose all of it.
+			bool GetBoundsFlag(void) const
+			{
+				return (boundsFlag);
+			}
+
+			// The axis-aligned bounds of the node's subtree in the file's global space.
+			const float *GetBoundsMin(void) const
+			{
+				return (boundsMin);
+			}
+
+			const float *GetBoundsMax(void) const
+			{
+				return (boundsMax);
+			}
+
 			bool ValidateSubstructure(const DataDescription *dataDescription, const Structure *structure) const;
 			DataResult ProcessData(DataDescription *dataDescription);
 	};
@@ -516,8 +612,16 @@ namespace OGEX
 			String				arrayAttrib;
 			unsigned_int32		morphIndex;
 
+			unsigned_int32		attribType;
+			unsigned_int32		attribIndex;
+
 			DataStructure<FloatDataType>* dataStructure;
 
+			float				boundsMin[3];
+			float				boundsMax[3];
+
+			void ClassifyArrayAttrib(void);
+
 		public:
 
 			VertexArrayStructure();
@@ -528,6 +632,16 @@ namespace OGEX
 				return (arrayAttrib);
 			}
 
+			unsigned_int32 GetAttribType(void) const
+			{
+				return (attribType);
+			}
+
+			unsigned_int32 GetAttribIndex(void) const
+			{
+				return (attribIndex);
+			}
+
 			unsigned_int32 GetMorphIndex(void) const
 			{
 				return (morphIndex);
@@ -538,6 +652,18 @@ namespace OGEX
 				return dataStructure;
 			}
 
+			// The axis-aligned bounds of a position array, found at parse time. Missing coordinates are zero,
+			// and the bounds of other attribs are left at zero.
+			const float *GetBoundsMin(void) const
+			{
+				return (boundsMin);
+			}
+
+			const float *GetBoundsMax(void) const
+			{
+				return (boundsMax);
+			}
+
 			bool ValidateProperty(const DataDescription *dataDescription, const String& identifier, DataType *type, void **value);
 			bool ValidateSubstructure(const DataDescription *dataDescription, const Structure *structure) const;
 			DataResult ProcessData(DataDescription *dataDescription);
@@ -550,12 +676,16 @@ namespace OGEX
 
 			unsigned_int32			materialIndex;
 			unsigned_int64			restartIndex;
+			bool					restartFlag;
 			String					frontFace;
 
 			PrimitiveStructure *primitiveStructure;
 
 			Array<unsigned_int32> indicesArray;
 
+			void ExpandQuads(void);
+			void ExpandTriangleStrip(void);
+
 		public:
 
 			IndexArrayStructure();
@@ -589,6 +719,8 @@ namespace OGEX
 			bool ValidateProperty(const DataDescription *dataDescription, const String& identifier, DataType *type, void **value);
 			bool ValidateSubstructure(const DataDescription *dataDescription, const Structure *structure) const;
 			DataResult ProcessData(DataDescription *dataDescription);
+
+			DataResult ExpandPrimitives(const String& primitive);
 	};
 
 
@@ -729,10 +861,40 @@ namespace OGEX
 	};
 
 
+	// The bone influences of one skinned vertex, pointing into the skin's bone index and bone weight arrays.
+	struct SkinInfluenceSpan
+	{
+		int32					influenceCount;
+		const unsigned_int16	*boneIndexArray;
+		const float				*boneWeightArray;
+	};
+
+
 	class SkinStructure : public OpenGexStructure
 	{
 		private:
 
+			enum
+			{
+				kInfluenceOffsetBlockSize = 16384
+			};
+
+			struct InfluenceOffsetJob
+			{
+				const unsigned_int16	*boneCountArray;
+				int32					vertexCount;
+				int32					*influenceOffsetArray;
+				int32					*blockSumArray;
+			};
+
+			static void SumInfluenceCountBlock(int32 jobIndex, void *cookie);
+			static void WriteInfluenceOffsetBlock(int32 jobIndex, void *cookie);
+
+			int32 CalculateInfluenceOffsets(DataDescription *dataDescription, const unsigned_int16 *boneCountArray, int32 vertexCount);
+
+			int32								*influenceOffsetArray;
+
+			const TransformStructure			*transformStructure;
 			const SkeletonStructure				*skeletonStructure;
 			const BoneCountArrayStructure		*boneCountArrayStructure;
 			const BoneIndexArrayStructure		*boneIndexArrayStructure;
@@ -743,6 +905,44 @@ namespace OGEX
 			SkinStructure();
 			~SkinStructure();
 
+			// Returns the bind-pose transform of the skinned mesh, or nullptr if the skin doesn't have one.
+			const TransformStructure *GetTransformStructure(void) const
+			{
+				return (transformStructure);
+			}
+
+			const SkeletonStructure *GetSkeletonStructure(void) const
+			{
+				return (skeletonStructure);
+			}
+
+			const BoneCountArrayStructure *GetBoneCountArrayStructure(void) const
+			{
+				return (boneCountArrayStructure);
+			}
+
+			const BoneIndexArrayStructure *GetBoneIndexArrayStructure(void) const
+			{
+				return (boneIndexArrayStructure);
+			}
+
+			const BoneWeightArrayStructure *GetBoneWeightArrayStructure(void) const
+			{
+				return (boneWeightArrayStructure);
+			}
+
+			// Returns the exclusive prefix sum of the bone counts, one entry per vertex plus the total influence count at the end.
+			const int32 *GetInfluenceOffsetArray(void) const
+			{
+				return (influenceOffsetArray);
+			}
+
+			SkinInfluenceSpan GetInfluences(int32 vertexIndex) const
+			{
+				int32 offset = influenceOffsetArray[vertexIndex];
+				return {influenceOffsetArray[vertexIndex + 1] - offset, boneIndexArrayStructure->GetBoneIndexArray() + offset, boneWeightArrayStructure->GetBoneWeightArray() + offset};
+			}
+
 			bool ValidateSubstructure(const DataDescription *dataDescription, const Structure *structure) const;
 			DataResult ProcessData(DataDescription *dataDescription);
 	};
@@ -810,6 +1010,8 @@ namespace OGEX
 			Array<VertexArrayStructure*> vertexArrayStructures;
 			Array<IndexArrayStructure*> indexArrayStructures;
 
+			VertexArrayStructure	*vertexAttribTable[kVertexAttribCount][kMaxVertexAttribIndex];
+
 			SkinStructure			*skinStructure;
 
 		public:
@@ -847,6 +1049,16 @@ namespace OGEX
 				return indexArrayStructures;
 			}
 
+			// Returns the non-morph vertex array for the given attribute, or nullptr if the mesh doesn't have one.
+			VertexArrayStructure *GetVertexArray(unsigned_int32 attrib, unsigned_int32 index = 0) const
+			{
+				return (vertexAttribTable[attrib][index]);
+			}
+
+			// Returns the first vertex array of the given attribute that belongs to a morph target, or nullptr if
+			// the morph target leaves that attribute unchanged. Morph index 0 returns the base vertex array.
+			VertexArrayStructure *GetMorphVertexArray(unsigned_int32 attrib, unsigned_int32 morphIndex) const;
+
 			SkinStructure *GetSkinStructure(void) const
 			{
 				return (skinStructure);
@@ -1212,6 +1424,8 @@ namespace OGEX
 			String			keyKind;
 			bool			scalarFlag;
 
+			const float		*keyData;
+
 		public:
 
 			KeyStructure();
@@ -1222,6 +1436,12 @@ namespace OGEX
 				return (keyKind);
 			}
 
+			// Returns the key data, one element per key for scalar kinds and one subarray per key otherwise.
+			const float *GetKeyData(void) const
+			{
+				return (keyData);
+			}
+
 			bool GetScalarFlag(void) const
 			{
 				return (scalarFlag);
@@ -1309,11 +1529,21 @@ namespace OGEX
 
 	class ValueStructure : public CurveStructure
 	{
+		private:
+
+			int32		valueSize;
+
 		public:
 
 			ValueStructure();
 			~ValueStructure();
 
+			// Returns the number of floats in each value, which matches the data layout of the track's target.
+			int32 GetValueSize(void) const
+			{
+				return (valueSize);
+			}
+
 			DataResult ProcessData(DataDescription *dataDescription);
 	};
 
@@ -1353,6 +1583,32 @@ namespace OGEX
 				return (valueStructure);
 			}
 
+			int32 GetKeyCount(void) const
+			{
+				return (timeStructure->GetKeyDataElementCount());
+			}
+
+			float GetBeginTime(void) const
+			{
+				return (timeStructure->GetKeyValueStructure()->GetKeyData()[0]);
+			}
+
+			float GetEndTime(void) const
+			{
+				return (timeStructure->GetKeyValueStructure()->GetKeyData()[GetKeyCount() - 1]);
+			}
+
+			// Samples the track's curves at the given time and writes GetValueStructure()->GetValueSize() floats.
+			// Times outside the keys are clamped to the first or last key.
+			void EvaluateTrack(float time, float *result) const
+			{
+				EvaluateTrack(1, &time, result);
+			}
+
+			// Samples the track at timeCount times and writes GetValueStructure()->GetValueSize() floats per time.
+			// Any time order works, but increasing times reuse the previous key segment without searching.
+			void EvaluateTrack(int32 timeCount, const float *timeArray, float *result) const;
+
 			bool ValidateProperty(const DataDescription *dataDescription, const String& identifier, DataType *type, void **value);
 			bool ValidateSubstructure(const DataDescription *dataDescription, const Structure *structure) const;
 			DataResult ProcessData(DataDescription *dataDescription);
@@ -1458,7 +1714,22 @@ namespace OGEX
 			ODDL::String	upDirection;
 			ODDL::String	forwardDirection;
 
-			DataResult ProcessData(void);
+			Array<NodeStructure *>		rootNodeArray;
+
+			struct TrackEvaluationJob
+			{
+				const TrackStructure *const		*trackArray;
+				int32							timeCount;
+				const float						*timeArray;
+				float *const					*resultArray;
+			};
+
+			static void EvaluateTrackJob(int32 jobIndex, void *cookie);
+			static void CalculateSubtreeTransformsJob(int32 jobIndex, void *cookie);
+
+		protected:
+
+			DataResult ProcessData(void) override;
 
 		public:
 
@@ -1515,6 +1786,10 @@ namespace OGEX
 				forwardDirection = direction;
 			}
 
+			// Samples trackCount tracks at the same timeCount times, with one parallel job per track.
+			// Track i writes timeCount * GetValueSize() floats to resultArray[i].
+			void EvaluateTracks(int32 trackCount, const TrackStructure *const *trackArray, int32 timeCount, const float *timeArray, float *const *resultArray);
+
 			Structure *CreateStructure(const String& identifier) const;
 			bool ValidateTopLevelStructure(const Structure *structure) const;
 	};
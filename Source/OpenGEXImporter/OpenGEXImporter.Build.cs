@@ -36,6 +36,8 @@ namespace UnrealBuildTool.Rules
 					"MeshDescription",
 					"MeshUtilities",
                     "MessageLog",
+					"ImageWrapper",
+					"Json",
 				}
 				);
 
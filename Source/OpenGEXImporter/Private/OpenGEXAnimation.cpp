@@ -0,0 +1,389 @@
+#include "OpenGEXAnimation.h"
+
+#include "Animation/AnimSequence.h"
+#include "Animation/Skeleton.h"
+#include "ReferenceSkeleton.h"
+#include "AssetRegistryModule.h"
+#include "Async/ParallelFor.h"
+#include "HAL/ThreadSafeBool.h"
+#include "OpenGEXUtility.h"
+#include "OpenGEXAssetImportData.h"
+#include "OpenGEXImportSettings.h"
+#include "OpenGEXCommons.h"
+
+/** The tracks of one clip, by the matrix structure they animate. */
+typedef TMap<const OGEX::MatrixStructure*, const OGEX::TrackStructure*> FOpenGEXClipTracks;
+
+/** Every track of a clip sampled at every frame, by the matrix structure it animates. */
+struct FOpenGEXBakedTracks
+{
+	TMap<const OGEX::MatrixStructure*, TArray<float>> Samples;
+	int32 NumFrames = 0;
+
+	const float* Find(const OGEX::MatrixStructure* MatrixStruct, int32 Frame) const
+	{
+		const TArray<float>* TrackSamples = Samples.Find(MatrixStruct);
+		return TrackSamples ? TrackSamples->GetData() + Frame * (TrackSamples->Num() / NumFrames) : nullptr;
+	}
+};
+
+// Evaluates the tracks at NumFrames times spread evenly over [BeginTime, EndTime], both ends included.
+static void BakeTracksForOpenGEX(OGEX::OpenGexDataDescription* OpenGexDataDescriptionPtr, const FOpenGEXClipTracks& Tracks, float BeginTime, float EndTime, int32 NumFrames, FOpenGEXBakedTracks& OutBaked)
+{
+	TArray<float> Times;
+	Times.SetNumUninitialized(NumFrames);
+	for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+	{
+		Times[Frame] = FMath::Lerp(BeginTime, EndTime, float(Frame) / (NumFrames - 1));
+	}
+
+	TArray<const OGEX::TrackStructure*> TrackArray;
+	TArray<float*> ResultArray;
+	OutBaked.NumFrames = NumFrames;
+	OutBaked.Samples.Reserve(Tracks.Num());
+	for (const TPair<const OGEX::MatrixStructure*, const OGEX::TrackStructure*>& Track : Tracks)
+	{
+		TArray<float>& TrackSamples = OutBaked.Samples.Add(Track.Key);
+		TrackSamples.SetNumUninitialized(NumFrames * Track.Value->GetValueStructure()->GetValueSize());
+
+		TrackArray.Add(Track.Value);
+		ResultArray.Add(TrackSamples.GetData());
+	}
+
+	OpenGexDataDescriptionPtr->EvaluateTracks(TrackArray.Num(), TrackArray.GetData(), NumFrames, Times.GetData(), ResultArray.GetData());
+}
+
+// Builds the transform of a node at the given frame from its matrix substructures, with animated ones taken from the baked tracks.
+// Matrices flagged as object-only apply to the node itself but not to its subnodes.
+static FMatrix CalculateNodeMatrixForOpenGEX(const Structure* Node, const FOpenGEXBakedTracks& Baked, int32 Frame, bool bIncludeObjectOnly, const FOpenGEXSpaceConversion& Conversion)
+{
+	FMatrix Result = FMatrix::Identity;
+
+	for (const Structure* Substructure = Node->GetFirstSubnode(); Substructure; Substructure = Substructure->Next())
+	{
+		if (Substructure->GetBaseStructureType() != OGEX::kStructureMatrix)
+			continue;
+
+		const OGEX::MatrixStructure* MatrixStruct = static_cast<const OGEX::MatrixStructure*>(Substructure);
+		if (MatrixStruct->GetObjectFlag() && !bIncludeObjectOnly)
+			continue;
+
+		const float* Data = Baked.Find(MatrixStruct, Frame);
+		if (!Data)
+		{
+			Data = MatrixStruct->GetMatrixData();
+		}
+
+		float Matrix[16];
+		MatrixStruct->CalculateMatrix(Data, Matrix);
+
+		// OpenGEX multiplies the matrices in the order they appear, so in row-vector order each one goes in front.
+		Result = Conversion.ConvertTransform(Matrix) * Result;
+	}
+
+	return Result;
+}
+
+static FMatrix CalculateNodeGlobalMatrixForOpenGEX(const Structure* Node, const FOpenGEXBakedTracks& Baked, int32 Frame, const FOpenGEXSpaceConversion& Conversion)
+{
+	FMatrix Result = CalculateNodeMatrixForOpenGEX(Node, Baked, Frame, true, Conversion);
+	for (const Structure* Ancestor = Node->GetSuperNode(); Ancestor && Ancestor->GetBaseStructureType() == OGEX::kStructureNode; Ancestor = Ancestor->GetSuperNode())
+	{
+		Result = Result * CalculateNodeMatrixForOpenGEX(Ancestor, Baked, Frame, false, Conversion);
+	}
+
+	return Result;
+}
+
+struct FOpenGEXKeyTolerance
+{
+	float Position = 0.0f;
+	float Rotation = 0.0f;
+	float Scale = 0.0f;
+};
+
+/** Local bone transforms sampled at evenly spaced times over a clip, stored frame by frame. */
+struct FOpenGEXSampledAnimation
+{
+	int32 NumBones = 0;
+	int32 NumFrames = 0;
+	TArray<FTransform> Transforms;
+
+	const FTransform& Get(int32 Frame, int32 BoneIndex) const
+	{
+		return Transforms[Frame * NumBones + BoneIndex];
+	}
+};
+
+static void SampleAnimationForOpenGEX(const FOpenGEXBakedTracks& Baked, const FReferenceSkeleton& RefSkeleton, const TArray<const OGEX::NodeStructure*>& BoneNodes, const FOpenGEXSpaceConversion& Conversion, FOpenGEXSampledAnimation& Sampled)
+{
+	const int32 NumBones = Sampled.NumBones;
+	Sampled.Transforms.SetNum(Sampled.NumFrames * NumBones);
+
+	ParallelFor(Sampled.NumFrames, [&](int32 Frame)
+	{
+		TArray<FMatrix> GlobalMatrices;
+		GlobalMatrices.SetNumUninitialized(NumBones);
+		for (int32 BoneIndex = 0; BoneIndex < NumBones; ++BoneIndex)
+		{
+			GlobalMatrices[BoneIndex] = BoneNodes[BoneIndex] ? CalculateNodeGlobalMatrixForOpenGEX(BoneNodes[BoneIndex], Baked, Frame, Conversion) : FMatrix::Identity;
+
+			const int32 ParentIndex = RefSkeleton.GetParentIndex(BoneIndex);
+			const FMatrix LocalMatrix = (ParentIndex != INDEX_NONE) ? GlobalMatrices[BoneIndex] * GlobalMatrices[ParentIndex].Inverse() : GlobalMatrices[BoneIndex];
+			Sampled.Transforms[Frame * NumBones + BoneIndex] = FTransform(LocalMatrix);
+		}
+	});
+
+	// Keep every bone's rotations in one hemisphere, so interpolating between neighboring keys takes the short way.
+	ParallelFor(NumBones, [&](int32 BoneIndex)
+	{
+		for (int32 Frame = 1; Frame < Sampled.NumFrames; ++Frame)
+		{
+			FTransform& Transform = Sampled.Transforms[Frame * NumBones + BoneIndex];
+			if ((Transform.GetRotation() | Sampled.Get(Frame - 1, BoneIndex).GetRotation()) < 0.0f)
+			{
+				Transform.SetRotation(Transform.GetRotation() * -1.0f);
+			}
+		}
+	});
+}
+
+// Whether interpolating between the keys reproduces every dense sample of every bone within the tolerances. Both
+// span the same time range, so a sampled frame lies at Frame * (NumKeys - 1) / (NumFrames - 1) between the keys.
+static bool AreKeysWithinToleranceForOpenGEX(const FOpenGEXSampledAnimation& Sampled, const FOpenGEXSampledAnimation& Keys, const FOpenGEXKeyTolerance& Tolerance)
+{
+	const float KeysPerFrame = float(Keys.NumFrames - 1) / (Sampled.NumFrames - 1);
+
+	FThreadSafeBool bExceeded = false;
+	ParallelFor(Sampled.NumBones, [&](int32 BoneIndex)
+	{
+		for (int32 Frame = 0; Frame < Sampled.NumFrames && !bExceeded; ++Frame)
+		{
+			const float KeyTime = Frame * KeysPerFrame;
+			const int32 Key = FMath::Min(FMath::FloorToInt(KeyTime), Keys.NumFrames - 2);
+			const float Alpha = KeyTime - Key;
+
+			const FTransform& Key0 = Keys.Get(Key, BoneIndex);
+			const FTransform& Key1 = Keys.Get(Key + 1, BoneIndex);
+			const FTransform& Expected = Sampled.Get(Frame, BoneIndex);
+
+			const FVector Position = FMath::Lerp(Key0.GetTranslation(), Key1.GetTranslation(), Alpha);
+			const FQuat Rotation = FQuat::Slerp(Key0.GetRotation(), Key1.GetRotation(), Alpha);
+			const FVector Scale = FMath::Lerp(Key0.GetScale3D(), Key1.GetScale3D(), Alpha);
+
+			if (FVector::Dist(Position, Expected.GetTranslation()) > Tolerance.Position ||
+				Rotation.AngularDistance(Expected.GetRotation()) > Tolerance.Rotation ||
+				(Scale - Expected.GetScale3D()).GetAbsMax() > Tolerance.Scale)
+			{
+				bExceeded = true;
+			}
+		}
+	});
+
+	return !bExceeded;
+}
+
+// Looks for the smallest number of evenly spaced keys that reproduces the dense samples within the tolerances, with
+// Resample evaluating the clip at OutKeys.NumFrames times. The keys need not fall on sampled frames, so any count
+// from two up is a candidate. The error shrinks as keys are added in all but contrived cases, so this bisects between
+// two keys and one per sampled frame, which matches exactly; every count it settles on has been checked.
+// Returns false if no fewer keys than sampled frames will do, leaving OutKeys empty.
+static bool FindKeysForOpenGEX(const FOpenGEXSampledAnimation& Sampled, const FOpenGEXKeyTolerance& Tolerance, TFunctionRef<void(FOpenGEXSampledAnimation&)> Resample, FOpenGEXSampledAnimation& OutKeys)
+{
+	int32 MinKeys = 2;
+	int32 MaxKeys = Sampled.NumFrames;
+
+	FOpenGEXSampledAnimation Candidate;
+	while (MinKeys < MaxKeys)
+	{
+		Candidate.NumBones = Sampled.NumBones;
+		Candidate.NumFrames = MinKeys + (MaxKeys - MinKeys) / 2;
+		Resample(Candidate);
+
+		if (AreKeysWithinToleranceForOpenGEX(Sampled, Candidate, Tolerance))
+		{
+			MaxKeys = Candidate.NumFrames;
+			Swap(OutKeys, Candidate);
+		}
+		else
+		{
+			MinKeys = Candidate.NumFrames + 1;
+		}
+	}
+
+	return MaxKeys < Sampled.NumFrames;
+}
+
+// Writes the keys of one bone, collapsing each component that stays within the tolerances over the whole clip to a single key.
+static void BuildRawTrackForOpenGEX(const FOpenGEXSampledAnimation& Sampled, const FOpenGEXSampledAnimation& Keys, int32 BoneIndex, const FOpenGEXKeyTolerance& Tolerance, FRawAnimSequenceTrack& OutTrack)
+{
+	const FTransform& First = Sampled.Get(0, BoneIndex);
+
+	bool bConstantPosition = true;
+	bool bConstantRotation = true;
+	bool bConstantScale = true;
+	for (int32 Frame = 0; Frame < Sampled.NumFrames; ++Frame)
+	{
+		const FTransform& Transform = Sampled.Get(Frame, BoneIndex);
+		bConstantPosition &= FVector::Dist(Transform.GetTranslation(), First.GetTranslation()) <= Tolerance.Position;
+		bConstantRotation &= Transform.GetRotation().AngularDistance(First.GetRotation()) <= Tolerance.Rotation;
+		bConstantScale &= (Transform.GetScale3D() - First.GetScale3D()).GetAbsMax() <= Tolerance.Scale;
+	}
+
+	const int32 NumKeys = Keys.NumFrames;
+	OutTrack.PosKeys.Reserve(bConstantPosition ? 1 : NumKeys);
+	OutTrack.RotKeys.Reserve(bConstantRotation ? 1 : NumKeys);
+	OutTrack.ScaleKeys.Reserve(bConstantScale ? 1 : NumKeys);
+
+	for (int32 Key = 0; Key < NumKeys; ++Key)
+	{
+		const FTransform& Transform = Keys.Get(Key, BoneIndex);
+		if (Key == 0 || !bConstantPosition)
+		{
+			OutTrack.PosKeys.Add(Transform.GetTranslation());
+		}
+		if (Key == 0 || !bConstantRotation)
+		{
+			OutTrack.RotKeys.Add(Transform.GetRotation());
+		}
+		if (Key == 0 || !bConstantScale)
+		{
+			OutTrack.ScaleKeys.Add(Transform.GetScale3D());
+		}
+	}
+}
+
+static const OGEX::ClipStructure* FindClipForOpenGEX(OGEX::OpenGexDataDescription* OpenGexDataDescriptionPtr, int32 ClipIndex)
+{
+	for (const Structure* StructureNode = OpenGexDataDescriptionPtr->GetRootStructure()->GetFirstSubnode(); StructureNode; StructureNode = StructureNode->Next())
+	{
+		if (StructureNode->GetStructureType() == OGEX::kStructureClip)
+		{
+			const OGEX::ClipStructure* ClipStruct = static_cast<const OGEX::ClipStructure*>(StructureNode);
+			if ((int32)ClipStruct->GetClipIndex() == ClipIndex)
+				return ClipStruct;
+		}
+	}
+
+	return nullptr;
+}
+
+TArray<UAnimSequence*> ImportAnimationsFromOpenGEX(OGEX::OpenGexDataDescription* OpenGexDataDescriptionPtr, USkeleton* Skeleton, const FReferenceSkeleton& RefSkeleton, const TArray<const OGEX::NodeStructure*>& BoneNodes, const FString& FileName, UObject* InParent, const FString& BaseName, FName InName, EObjectFlags Flags, FOpenGEXAssetNameCache& NameCache)
+{
+	TArray<UAnimSequence*> Result;
+
+	// Bones move with every node above them, so the animations of all those nodes contribute.
+	TSet<const Structure*> AnimatedNodes;
+	for (const OGEX::NodeStructure* BoneNode : BoneNodes)
+	{
+		for (const Structure* Node = BoneNode; Node && Node->GetBaseStructureType() == OGEX::kStructureNode; Node = Node->GetSuperNode())
+		{
+			AnimatedNodes.Add(Node);
+		}
+	}
+
+	TMap<int32, FOpenGEXClipTracks> ClipTracks;
+	for (const Structure* Node : AnimatedNodes)
+	{
+		for (const Structure* Substructure = Node->GetFirstSubnode(); Substructure; Substructure = Substructure->Next())
+		{
+			if (Substructure->GetStructureType() != OGEX::kStructureAnimation)
+				continue;
+
+			FOpenGEXClipTracks& Tracks = ClipTracks.FindOrAdd(static_cast<const OGEX::AnimationStructure*>(Substructure)->GetClipIndex());
+			for (const Structure* TrackNode = Substructure->GetFirstSubnode(); TrackNode; TrackNode = TrackNode->Next())
+			{
+				if (TrackNode->GetStructureType() != OGEX::kStructureTrack)
+					continue;
+
+				const OGEX::TrackStructure* TrackStruct = static_cast<const OGEX::TrackStructure*>(TrackNode);
+				const OGEX::AnimatableStructure* Target = TrackStruct->GetTargetStructure();
+				if (Target->GetBaseStructureType() == OGEX::kStructureMatrix)
+				{
+					Tracks.Add(static_cast<const OGEX::MatrixStructure*>(Target), TrackStruct);
+				}
+			}
+		}
+	}
+
+	ClipTracks.KeySort(TLess<int32>());
+
+	const UOpenGEXImportSettings* Settings = GetDefault<UOpenGEXImportSettings>();
+	FOpenGEXKeyTolerance Tolerance;
+	if (Settings->bReduceAnimationKeys)
+	{
+		Tolerance.Position = Settings->AnimationPositionTolerance;
+		Tolerance.Rotation = FMath::DegreesToRadians(Settings->AnimationRotationTolerance);
+		Tolerance.Scale = Settings->AnimationScaleTolerance;
+	}
+
+	const FOpenGEXSpaceConversion Conversion(OpenGexDataDescriptionPtr);
+
+	for (const TPair<int32, FOpenGEXClipTracks>& Clip : ClipTracks)
+	{
+		const FOpenGEXClipTracks& Tracks = Clip.Value;
+		if (Tracks.Num() == 0)
+			continue;
+
+		float BeginTime = TNumericLimits<float>::Max();
+		float EndTime = TNumericLimits<float>::Lowest();
+		for (const TPair<const OGEX::MatrixStructure*, const OGEX::TrackStructure*>& Track : Tracks)
+		{
+			BeginTime = FMath::Min(BeginTime, Track.Value->GetBeginTime());
+			EndTime = FMath::Max(EndTime, Track.Value->GetEndTime());
+		}
+
+		if (EndTime <= BeginTime)
+			continue;
+
+		const OGEX::ClipStructure* ClipStruct = FindClipForOpenGEX(OpenGexDataDescriptionPtr, Clip.Key);
+		const float FrameRate = (ClipStruct && ClipStruct->GetFrameRate() > 0.0f) ? ClipStruct->GetFrameRate() : 30.0f;
+		const FString ClipName = (ClipStruct && ClipStruct->GetClipName()) ? FString(UTF8_TO_TCHAR(ClipStruct->GetClipName())) : FString::Printf(TEXT("Anim_%d"), Clip.Key);
+
+		// The tracks are analytic curves, so the clip can be sampled again at whatever times the keys end up at.
+		auto SampleClip = [&](FOpenGEXSampledAnimation& OutSampled)
+		{
+			FOpenGEXBakedTracks Baked;
+			BakeTracksForOpenGEX(OpenGexDataDescriptionPtr, Tracks, BeginTime, EndTime, OutSampled.NumFrames, Baked);
+			SampleAnimationForOpenGEX(Baked, RefSkeleton, BoneNodes, Conversion, OutSampled);
+		};
+
+		FOpenGEXSampledAnimation Sampled;
+		Sampled.NumBones = RefSkeleton.GetNum();
+		Sampled.NumFrames = FMath::Max(FMath::RoundToInt((EndTime - BeginTime) * FrameRate) + 1, 2);
+		SampleClip(Sampled);
+
+		FOpenGEXSampledAnimation ReducedKeys;
+		const bool bReduced = Settings->bReduceAnimationKeys && FindKeysForOpenGEX(Sampled, Tolerance, SampleClip, ReducedKeys);
+		const FOpenGEXSampledAnimation& Keys = bReduced ? ReducedKeys : Sampled;
+
+		FString AnimName;
+		UPackage* AnimPackage = RetrieveAssetPackageAndName<UAnimSequence>(NameCache, InParent, BaseName + TEXT("_") + ClipName, TEXT("A"), InName, Clip.Key, AnimName);
+
+		UAnimSequence* AnimSequence = NewObject<UAnimSequence>(AnimPackage, FName(*AnimName), Flags);
+		AnimSequence->AssetImportData = UOpenGEXAssetImportData::Create(AnimSequence, FileName, FString());
+		AnimSequence->SetSkeleton(Skeleton);
+		AnimSequence->SequenceLength = FMath::Max(EndTime - BeginTime, MINIMUM_ANIMATION_LENGTH);
+		AnimSequence->SetRawNumberOfFrame(Keys.NumFrames);
+
+		for (int32 BoneIndex = 0; BoneIndex < Sampled.NumBones; ++BoneIndex)
+		{
+			FRawAnimSequenceTrack RawTrack;
+			BuildRawTrackForOpenGEX(Sampled, Keys, BoneIndex, Tolerance, RawTrack);
+			AnimSequence->AddNewRawTrack(RefSkeleton.GetBoneName(BoneIndex), &RawTrack);
+		}
+
+		UE_LOG(LogOpenGEXImporter, Log, TEXT("Animation '%s': %d keys for %d sampled frames"), *AnimName, Keys.NumFrames, Sampled.NumFrames);
+
+		AnimSequence->MarkRawDataAsModified();
+		AnimSequence->PostProcessSequence();
+		AnimSequence->PostEditChange();
+
+		FAssetRegistryModule::AssetCreated(AnimSequence);
+		AnimPackage->SetDirtyFlag(true);
+
+		Result.Add(AnimSequence);
+	}
+
+	return Result;
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectMacros.h"
+#include "OpenGEX.h"
+
+class UAnimSequence;
+class USkeleton;
+struct FReferenceSkeleton;
+class FOpenGEXAssetNameCache;
+
+/**
+ * Imports every animation clip that moves the given bones, or any node above them, as an animation sequence of the skeleton.
+ * BoneNodes holds the scene node of every reference skeleton bone, nullptr for bones without one.
+ */
+TArray<UAnimSequence*> ImportAnimationsFromOpenGEX(OGEX::OpenGexDataDescription* OpenGexDataDescriptionPtr, USkeleton* Skeleton, const FReferenceSkeleton& RefSkeleton, const TArray<const OGEX::NodeStructure*>& BoneNodes, const FString& FileName, UObject* InParent, const FString& BaseName, FName InName, EObjectFlags Flags, FOpenGEXAssetNameCache& NameCache);
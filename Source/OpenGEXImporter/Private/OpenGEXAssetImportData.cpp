@@ -0,0 +1,10 @@
+#include "OpenGEXAssetImportData.h"
+
+UOpenGEXAssetImportData* UOpenGEXAssetImportData::Create(UObject* Asset, const FString& FileName, const FString& ContentHash)
+{
+	UOpenGEXAssetImportData* ImportData = NewObject<UOpenGEXAssetImportData>(Asset, NAME_None);
+	ImportData->Update(FileName);
+	ImportData->ContentHash = ContentHash;
+
+	return ImportData;
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "EditorFramework/AssetImportData.h"
+
+#include "OpenGEXAssetImportData.generated.h"
+
+/**
+ * Import data of assets created from an OpenGEX file. Besides the source file it remembers a hash of the parsed
+ * structures the asset was built from, so a reimport can leave unchanged assets alone.
+ */
+UCLASS()
+class UOpenGEXAssetImportData : public UAssetImportData
+{
+	GENERATED_BODY()
+
+public:
+	/** Hash of the OpenGEX data the asset was last built from. */
+	UPROPERTY()
+	FString ContentHash;
+
+	static UOpenGEXAssetImportData* Create(UObject* Asset, const FString& FileName, const FString& ContentHash);
+};
+
+/** Returns the asset previously imported under this name if its stored content hash still matches, nullptr otherwise. */
+template <typename T>
+T* FindUnchangedOpenGEXAsset(UPackage* AssetPackage, const FString& AssetName, const FString& ContentHash)
+{
+	T* ExistingAsset = FindObject<T>(AssetPackage, *AssetName);
+	UOpenGEXAssetImportData* ImportData = ExistingAsset ? Cast<UOpenGEXAssetImportData>(ExistingAsset->AssetImportData) : nullptr;
+
+	return (ImportData && ImportData->ContentHash == ContentHash) ? ExistingAsset : nullptr;
+}
@@ -1,3 +1,76 @@
 #include "OpenGEXCommons.h"
 
-DEFINE_LOG_CATEGORY(LogOpenGEXImporter)
\ No newline at end of file
+#include "HAL/ThreadSafeCounter64.h"
+
+DEFINE_LOG_CATEGORY(LogOpenGEXImporter)
+
+DEFINE_STAT(STAT_OpenGEX_ReadFile);
+DEFINE_STAT(STAT_OpenGEX_ProcessText);
+DEFINE_STAT(STAT_OpenGEX_ProcessData);
+DEFINE_STAT(STAT_OpenGEX_ConvertMesh);
+DEFINE_STAT(STAT_OpenGEX_CreateMaterial);
+DEFINE_STAT(STAT_OpenGEX_DecodeTexture);
+DEFINE_STAT(STAT_OpenGEX_BuildMesh);
+DEFINE_STAT(STAT_OpenGEX_SavePackage);
+
+DEFINE_STAT(STAT_OpenGEX_Structures);
+DEFINE_STAT(STAT_OpenGEX_Vertices);
+DEFINE_STAT(STAT_OpenGEX_Triangles);
+DEFINE_STAT(STAT_OpenGEX_BytesParsed);
+
+thread_local FOpenGEXImportPhaseScope* FOpenGEXImportPhaseScope::Current = nullptr;
+
+static FThreadSafeCounter64 OpenGEXImportPhaseCycles[(int32)EOpenGEXImportPhase::Count];
+static FThreadSafeCounter64 OpenGEXImportCounts[(int32)EOpenGEXImportCounter::Count];
+
+void AddOpenGEXImportCycles(EOpenGEXImportPhase Phase, uint64 Cycles)
+{
+	OpenGEXImportPhaseCycles[(int32)Phase].Add((int64)Cycles);
+}
+
+void AddOpenGEXImportCount(EOpenGEXImportCounter Counter, int64 Count)
+{
+	OpenGEXImportCounts[(int32)Counter].Add(Count);
+}
+
+FOpenGEXImportTotals FOpenGEXImportTotals::Get()
+{
+	FOpenGEXImportTotals Totals;
+	for (int32 Phase = 0; Phase < (int32)EOpenGEXImportPhase::Count; ++Phase)
+	{
+		Totals.Seconds[Phase] = FPlatformTime::ToSeconds64((uint64)OpenGEXImportPhaseCycles[Phase].GetValue());
+	}
+	for (int32 Counter = 0; Counter < (int32)EOpenGEXImportCounter::Count; ++Counter)
+	{
+		Totals.Counts[Counter] = OpenGEXImportCounts[Counter].GetValue();
+	}
+	return Totals;
+}
+
+FOpenGEXImportTotals FOpenGEXImportTotals::operator-(const FOpenGEXImportTotals& Other) const
+{
+	FOpenGEXImportTotals Difference;
+	for (int32 Phase = 0; Phase < (int32)EOpenGEXImportPhase::Count; ++Phase)
+	{
+		Difference.Seconds[Phase] = Seconds[Phase] - Other.Seconds[Phase];
+	}
+	for (int32 Counter = 0; Counter < (int32)EOpenGEXImportCounter::Count; ++Counter)
+	{
+		Difference.Counts[Counter] = Counts[Counter] - Other.Counts[Counter];
+	}
+	return Difference;
+}
+
+const TCHAR* FOpenGEXImportTotals::GetPhaseName(EOpenGEXImportPhase Phase)
+{
+	static const TCHAR* PhaseNames[] = { TEXT("ReadFile"), TEXT("ProcessText"), TEXT("ProcessData"), TEXT("ConvertMesh"), TEXT("CreateMaterial"), TEXT("DecodeTexture"), TEXT("BuildMesh"), TEXT("SavePackage") };
+	static_assert(ARRAY_COUNT(PhaseNames) == (int32)EOpenGEXImportPhase::Count, "Phase names out of date");
+	return PhaseNames[(int32)Phase];
+}
+
+const TCHAR* FOpenGEXImportTotals::GetCounterName(EOpenGEXImportCounter Counter)
+{
+	static const TCHAR* CounterNames[] = { TEXT("Structures"), TEXT("Vertices"), TEXT("Triangles"), TEXT("BytesParsed") };
+	static_assert(ARRAY_COUNT(CounterNames) == (int32)EOpenGEXImportCounter::Count, "Counter names out of date");
+	return CounterNames[(int32)Counter];
+}
@@ -1,3 +1,119 @@
 #pragma once
 
-DECLARE_LOG_CATEGORY_EXTERN(LogOpenGEXImporter, Log, All);
\ No newline at end of file
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "Runtime/Launch/Resources/Version.h"
+#if ENGINE_MAJOR_VERSION > 4 || ENGINE_MINOR_VERSION >= 25
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#endif
+
+DECLARE_LOG_CATEGORY_EXTERN(LogOpenGEXImporter, Log, All);
+
+DECLARE_STATS_GROUP(TEXT("OpenGEXImporter"), STATGROUP_OpenGEXImporter, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Read File"), STAT_OpenGEX_ReadFile, STATGROUP_OpenGEXImporter, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("ProcessText"), STAT_OpenGEX_ProcessText, STATGROUP_OpenGEXImporter, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("ProcessData"), STAT_OpenGEX_ProcessData, STATGROUP_OpenGEXImporter, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Convert Mesh"), STAT_OpenGEX_ConvertMesh, STATGROUP_OpenGEXImporter, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Create Material"), STAT_OpenGEX_CreateMaterial, STATGROUP_OpenGEXImporter, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Decode Texture"), STAT_OpenGEX_DecodeTexture, STATGROUP_OpenGEXImporter, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Build Mesh"), STAT_OpenGEX_BuildMesh, STATGROUP_OpenGEXImporter, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Save Package"), STAT_OpenGEX_SavePackage, STATGROUP_OpenGEXImporter, );
+
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Structures"), STAT_OpenGEX_Structures, STATGROUP_OpenGEXImporter, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Vertices"), STAT_OpenGEX_Vertices, STATGROUP_OpenGEXImporter, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Triangles"), STAT_OpenGEX_Triangles, STATGROUP_OpenGEXImporter, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Bytes Parsed"), STAT_OpenGEX_BytesParsed, STATGROUP_OpenGEXImporter, );
+
+enum class EOpenGEXImportPhase : uint8
+{
+	ReadFile,
+	ProcessText,
+	ProcessData,
+	ConvertMesh,
+	CreateMaterial,
+	DecodeTexture,
+	BuildMesh,
+	SavePackage,
+	Count
+};
+
+enum class EOpenGEXImportCounter : uint8
+{
+	Structures,
+	Vertices,
+	Triangles,
+	BytesParsed,
+	Count
+};
+
+// Process-wide totals kept next to the stats system, so they can be reported without stats being enabled.
+// Phase times are CPU seconds: phases run on several threads at once are summed, and a phase nested in another on the
+// same thread is charged only to itself, so the phases never count the same time twice.
+struct FOpenGEXImportTotals
+{
+	double Seconds[(int32)EOpenGEXImportPhase::Count] = {};
+	int64 Counts[(int32)EOpenGEXImportCounter::Count] = {};
+
+	static FOpenGEXImportTotals Get();
+
+	FOpenGEXImportTotals operator-(const FOpenGEXImportTotals& Other) const;
+
+	static const TCHAR* GetPhaseName(EOpenGEXImportPhase Phase);
+	static const TCHAR* GetCounterName(EOpenGEXImportCounter Counter);
+};
+
+void AddOpenGEXImportCycles(EOpenGEXImportPhase Phase, uint64 Cycles);
+void AddOpenGEXImportCount(EOpenGEXImportCounter Counter, int64 Count);
+
+class FOpenGEXImportPhaseScope
+{
+public:
+	explicit FOpenGEXImportPhaseScope(EOpenGEXImportPhase InPhase)
+		: Phase(InPhase)
+		, Parent(Current)
+		, StartCycles(FPlatformTime::Cycles64())
+	{
+		Current = this;
+	}
+
+	~FOpenGEXImportPhaseScope()
+	{
+		const uint64 Cycles = FPlatformTime::Cycles64() - StartCycles;
+		AddOpenGEXImportCycles(Phase, Cycles);
+
+		// The enclosing phase skips the time spent in this one.
+		if (Parent)
+		{
+			Parent->StartCycles += Cycles;
+		}
+		Current = Parent;
+	}
+
+private:
+	EOpenGEXImportPhase Phase;
+	FOpenGEXImportPhaseScope* Parent;
+	uint64 StartCycles;
+
+	/** The innermost phase running on this thread. */
+	static thread_local FOpenGEXImportPhaseScope* Current;
+};
+
+#if ENGINE_MAJOR_VERSION > 4 || ENGINE_MINOR_VERSION >= 25
+#define OPENGEX_TRACE_SCOPE(Phase) TRACE_CPUPROFILER_EVENT_SCOPE(OpenGEX_##Phase)
+#else
+#define OPENGEX_TRACE_SCOPE(Phase)
+#endif
+
+// Times the enclosing scope as an Unreal Insights event, a "stat OpenGEXImporter" cycle counter and a phase total.
+#define OPENGEX_IMPORT_SCOPE(Phase) \
+	OPENGEX_TRACE_SCOPE(Phase); \
+	SCOPE_CYCLE_COUNTER(STAT_OpenGEX_##Phase); \
+	FOpenGEXImportPhaseScope PREPROCESSOR_JOIN(OpenGEXImportPhaseScope, __LINE__)(EOpenGEXImportPhase::Phase)
+
+#define OPENGEX_IMPORT_COUNT(Counter, Amount) \
+	do \
+	{ \
+		INC_DWORD_STAT_BY(STAT_OpenGEX_##Counter, Amount); \
+		AddOpenGEXImportCount(EOpenGEXImportCounter::Counter, Amount); \
+	} while (0)
@@ -0,0 +1,369 @@
+#include "OpenGEXImportCommandlet.h"
+
+#include "Async/Async.h"
+#include "Dom/JsonObject.h"
+#include "Engine/SkeletalMesh.h"
+#include "Engine/StaticMesh.h"
+#include "FileHelpers.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/FeedbackContext.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "ObjectTools.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectHash.h"
+#include "OpenGEX.h"
+#include "OpenGEXImporterFactory.h"
+#include "OpenGEXCommons.h"
+
+struct FOpenGEXCommandletFile
+{
+	FString FileName;
+	TUniquePtr<FOpenGEXInstrumentedDataDescription> DataDescription;
+	bool bParsed = false;
+	double ParseSeconds = 0.0;
+};
+
+static TArray<FString> GatherOpenGEXFiles(const FString& Source)
+{
+	TArray<FString> Files;
+
+	if (IFileManager::Get().DirectoryExists(*Source))
+	{
+		IFileManager::Get().FindFilesRecursive(Files, *Source, TEXT("*.ogex"), true, false);
+		Files.Sort();
+	}
+	else
+	{
+		TArray<FString> Lines;
+		if (FFileHelper::LoadFileToStringArray(Lines, *Source))
+		{
+			const FString ManifestDir = FPaths::GetPath(Source);
+			for (FString& Line : Lines)
+			{
+				Line.TrimStartAndEndInline();
+				if (Line.IsEmpty() || Line.StartsWith(TEXT("#")))
+				{
+					continue;
+				}
+
+				Files.Add(FPaths::IsRelative(Line) ? FPaths::Combine(ManifestDir, Line) : Line);
+			}
+		}
+	}
+
+	for (FString& File : Files)
+	{
+		File = FPaths::ConvertRelativePathToFull(File);
+	}
+
+	return Files;
+}
+
+// Mirrors the directory of the file below the source root under Dest, so files with the same name in different
+// directories don't import over each other. Folders that would still collide, e.g. for files outside the root or
+// names that only differ in case or in characters that get sanitized away, get a numeric suffix.
+static FString GetOpenGEXDestinationFolder(const FString& FileName, const FString& SourceRoot, const FString& DestPath, TSet<FString>& UsedFolders)
+{
+	FString Folder = DestPath;
+
+	FString RelativePath = FileName;
+	if (FPaths::MakePathRelativeTo(RelativePath, *(SourceRoot / TEXT(""))) && !RelativePath.StartsWith(TEXT("..")))
+	{
+		TArray<FString> Directories;
+		FPaths::GetPath(RelativePath).ParseIntoArray(Directories, TEXT("/"));
+		for (const FString& Directory : Directories)
+		{
+			Folder /= ObjectTools::SanitizeObjectName(Directory);
+		}
+	}
+
+	Folder /= ObjectTools::SanitizeObjectName(FPaths::GetBaseFilename(FileName));
+
+	FString UniqueFolder = Folder;
+	for (int32 Suffix = 2; UsedFolders.Contains(UniqueFolder); ++Suffix)
+	{
+		UniqueFolder = FString::Printf(TEXT("%s_%d"), *Folder, Suffix);
+	}
+
+	UsedFolders.Add(UniqueFolder);
+	return UniqueFolder;
+}
+
+static TFuture<TSharedPtr<FOpenGEXCommandletFile>> ParseOpenGEXFileAsync(const FString& FileName, bool bMemoryAccounting)
+{
+	return Async<TSharedPtr<FOpenGEXCommandletFile>>(EAsyncExecution::ThreadPool, [FileName, bMemoryAccounting]()
+	{
+		TSharedPtr<FOpenGEXCommandletFile> File = MakeShared<FOpenGEXCommandletFile>();
+		File->FileName = FileName;
+		File->DataDescription = MakeUnique<FOpenGEXInstrumentedDataDescription>();
+		File->DataDescription->SetMemoryAccountingEnabled(bMemoryAccounting);
+
+		const double StartTime = FPlatformTime::Seconds();
+		File->bParsed = ParseOpenGEXFile(FileName, *File->DataDescription);
+		File->ParseSeconds = FPlatformTime::Seconds() - StartTime;
+
+		return File;
+	});
+}
+
+static void AddOpenGEXPhaseFields(TSharedRef<FJsonObject> Report, const FOpenGEXImportTotals& Totals)
+{
+	for (int32 Phase = 0; Phase < (int32)EOpenGEXImportPhase::Count; ++Phase)
+	{
+		Report->SetNumberField(FString(FOpenGEXImportTotals::GetPhaseName((EOpenGEXImportPhase)Phase)) + TEXT("CpuSeconds"), Totals.Seconds[Phase]);
+	}
+	for (int32 Counter = 0; Counter < (int32)EOpenGEXImportCounter::Count; ++Counter)
+	{
+		Report->SetNumberField(FOpenGEXImportTotals::GetCounterName((EOpenGEXImportCounter)Counter), (double)Totals.Counts[Counter]);
+	}
+}
+
+static bool PackageContainsAsset(UPackage* Package)
+{
+	TArray<UObject*> Objects;
+	GetObjectsWithOuter(Package, Objects, false);
+	return Objects.ContainsByPredicate([](const UObject* Object) { return Object->IsAsset(); });
+}
+
+static int32 SaveOpenGEXPackages(TArray<UPackage*>& Packages)
+{
+	int32 NumFailed = 0;
+
+	for (UPackage* Package : Packages)
+	{
+		OPENGEX_IMPORT_SCOPE(SavePackage);
+
+		const FString PackageFileName = FPackageName::LongPackageNameToFilename(Package->GetName(), FPackageName::GetAssetPackageExtension());
+		if (!UPackage::SavePackage(Package, nullptr, RF_Standalone, *PackageFileName, GError, nullptr, false, true, SAVE_NoError))
+		{
+			UE_LOG(LogOpenGEXImporter, Error, TEXT("Failed to save package '%s'"), *Package->GetName());
+			NumFailed += 1;
+		}
+	}
+
+	Packages.Reset();
+
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+
+	return NumFailed;
+}
+
+UOpenGEXImportCommandlet::UOpenGEXImportCommandlet(const FObjectInitializer& ObjectInitializer /*= FObjectInitializer::Get()*/)
+	: Super(ObjectInitializer)
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UOpenGEXImportCommandlet::Main(const FString& Params)
+{
+	FString Source;
+	FString DestPath = TEXT("/Game/OpenGEX");
+	FString ReportFileName;
+	FString CsvFileName;
+	int32 SaveBatchSize = 32;
+
+	if (!FParse::Value(*Params, TEXT("Source="), Source) && !FParse::Value(*Params, TEXT("Manifest="), Source))
+	{
+		UE_LOG(LogOpenGEXImporter, Error, TEXT("Usage: -run=OpenGEXImport -Source=<Directory|Manifest> [-Dest=/Game/Path] [-Report=File.json] [-Csv=File.csv] [-SaveBatch=N] [-MemoryAccounting]"));
+		return 1;
+	}
+
+	FParse::Value(*Params, TEXT("Dest="), DestPath);
+	FParse::Value(*Params, TEXT("Report="), ReportFileName);
+	FParse::Value(*Params, TEXT("Csv="), CsvFileName);
+	FParse::Value(*Params, TEXT("SaveBatch="), SaveBatchSize);
+	SaveBatchSize = FMath::Max(SaveBatchSize, 1);
+	const bool bMemoryAccounting = FParse::Param(*Params, TEXT("MemoryAccounting"));
+
+	if (!FPackageName::IsValidLongPackageName(DestPath / TEXT("X")))
+	{
+		UE_LOG(LogOpenGEXImporter, Error, TEXT("Invalid destination path '%s'"), *DestPath);
+		return 1;
+	}
+
+	const TArray<FString> Files = GatherOpenGEXFiles(Source);
+	const FString SourceRoot = FPaths::ConvertRelativePathToFull(IFileManager::Get().DirectoryExists(*Source) ? Source : FPaths::GetPath(Source));
+	TSet<FString> UsedFolders;
+	UE_LOG(LogOpenGEXImporter, Display, TEXT("Importing %d OpenGEX files into %s"), Files.Num(), *DestPath);
+
+	const double TotalStartTime = FPlatformTime::Seconds();
+
+	// Parsing runs ahead on the thread pool, bounded so that only a few parsed files are held in memory at once.
+	// Everything that touches UObjects stays on this thread.
+	const int32 MaxFilesInFlight = FMath::Max(FPlatformMisc::NumberOfCoresIncludingHyperthreads(), 2);
+	TArray<TFuture<TSharedPtr<FOpenGEXCommandletFile>>> PendingFiles;
+	PendingFiles.SetNum(Files.Num());
+
+	int32 NextFileToParse = 0;
+	auto KickParsing = [&](int32 FileIndex)
+	{
+		while (NextFileToParse < Files.Num() && NextFileToParse < FileIndex + MaxFilesInFlight)
+		{
+			PendingFiles[NextFileToParse] = ParseOpenGEXFileAsync(Files[NextFileToParse], bMemoryAccounting);
+			NextFileToParse += 1;
+		}
+	};
+
+	TArray<TSharedPtr<FJsonValue>> FileReports;
+	TArray<FString> CsvLines;
+	CsvLines.Add(TEXT("File,Succeeded,ReadSeconds,TokenizeSeconds,ProcessDataSeconds,ConvertMeshCpuSeconds,CreateMaterialCpuSeconds,DecodeTextureCpuSeconds,BuildMeshCpuSeconds,ImportSeconds,SaveSeconds,Structures,BytesParsed,Vertices,Triangles,StaticMeshes,SkeletalMeshes,Assets"));
+	TArray<UPackage*> PackagesToSave;
+	TSet<UPackage*> SeenPackages;
+	int32 NumFailedFiles = 0;
+	int32 NumFailedPackages = 0;
+	int32 NumAssets = 0;
+	double SaveSeconds = 0.0;
+
+	for (int32 FileIndex = 0; FileIndex < Files.Num(); FileIndex++)
+	{
+		KickParsing(FileIndex);
+
+		TSharedPtr<FOpenGEXCommandletFile> File = PendingFiles[FileIndex].Get();
+		PendingFiles[FileIndex] = TFuture<TSharedPtr<FOpenGEXCommandletFile>>();
+
+		const FString BaseName = ObjectTools::SanitizeObjectName(FPaths::GetBaseFilename(File->FileName));
+		const FString DestFolder = GetOpenGEXDestinationFolder(File->FileName, SourceRoot, DestPath, UsedFolders);
+
+		const FOpenGEXParseStats& ParseStats = File->DataDescription->ParseStats;
+
+		TSharedRef<FJsonObject> FileReport = MakeShared<FJsonObject>();
+		FileReport->SetStringField(TEXT("File"), File->FileName);
+		FileReport->SetNumberField(TEXT("ParseSeconds"), File->ParseSeconds);
+
+		int32 NumStaticMeshes = 0;
+		int32 NumSkeletalMeshes = 0;
+		int32 NumFileAssets = 0;
+		double ImportSeconds = 0.0;
+		double FileSaveSeconds = 0.0;
+
+		// Only this file is being imported right now, so the change in the totals belongs to it. Parsing of the
+		// files ahead runs concurrently, which is why the parse side is taken from the file's own description.
+		const FOpenGEXImportTotals TotalsBefore = FOpenGEXImportTotals::Get();
+
+		if (File->bParsed)
+		{
+			const double ImportStartTime = FPlatformTime::Seconds();
+
+			UPackage* Parent = CreatePackage(nullptr, *(DestFolder / BaseName));
+			TArray<UObject*> Meshes = ImportMeshesAndMaterialsFromOpenGEX(File->DataDescription.Get(), File->FileName, Parent, FName(*BaseName), RF_Public | RF_Standalone, GWarn);
+			for (UObject* Mesh : Meshes)
+			{
+				NumStaticMeshes += Mesh->IsA<UStaticMesh>() ? 1 : 0;
+				NumSkeletalMeshes += Mesh->IsA<USkeletalMesh>() ? 1 : 0;
+			}
+
+			ImportSeconds = FPlatformTime::Seconds() - ImportStartTime;
+
+			// Every created or updated asset lives in its own dirty package.
+			TArray<UPackage*> DirtyPackages;
+			FEditorFileUtils::GetDirtyContentPackages(DirtyPackages);
+			for (UPackage* Package : DirtyPackages)
+			{
+				if (!SeenPackages.Contains(Package) && PackageContainsAsset(Package))
+				{
+					SeenPackages.Add(Package);
+					PackagesToSave.Add(Package);
+					NumFileAssets += 1;
+				}
+			}
+		}
+		else
+		{
+			UE_LOG(LogOpenGEXImporter, Error, TEXT("Failed to parse '%s'"), *File->FileName);
+			NumFailedFiles += 1;
+		}
+
+		NumAssets += NumFileAssets;
+
+		// A batch save is charged to the file that completes the batch.
+		if ((FileIndex + 1) % SaveBatchSize == 0 || FileIndex + 1 == Files.Num())
+		{
+			const double SaveStartTime = FPlatformTime::Seconds();
+			SeenPackages.Reset();
+			NumFailedPackages += SaveOpenGEXPackages(PackagesToSave);
+			FileSaveSeconds = FPlatformTime::Seconds() - SaveStartTime;
+			SaveSeconds += FileSaveSeconds;
+		}
+
+		const FOpenGEXImportTotals FileTotals = FOpenGEXImportTotals::Get() - TotalsBefore;
+		// Files without geometry still succeed, their mesh counts are reported separately.
+		const bool bSucceeded = File->bParsed;
+
+		FileReport->SetBoolField(TEXT("Succeeded"), bSucceeded);
+		FileReport->SetNumberField(TEXT("ImportSeconds"), ImportSeconds);
+		FileReport->SetNumberField(TEXT("SaveSeconds"), FileSaveSeconds);
+		AddOpenGEXPhaseFields(FileReport, FileTotals);
+		// Wall times of the parse, which overlap each other and the exclusive phase CPU times above.
+		FileReport->SetNumberField(TEXT("ReadFileWallSeconds"), ParseStats.ReadSeconds);
+		FileReport->SetNumberField(TEXT("ParseWallSeconds"), ParseStats.ProcessTextSeconds);
+		FileReport->SetNumberField(TEXT("TokenizeWallSeconds"), ParseStats.ProcessTextSeconds - ParseStats.ProcessDataSeconds);
+		FileReport->SetNumberField(TEXT("ProcessDataWallSeconds"), ParseStats.ProcessDataSeconds);
+		FileReport->SetNumberField(TEXT("Structures"), (double)ParseStats.Structures);
+		FileReport->SetNumberField(TEXT("BytesParsed"), (double)ParseStats.BytesParsed);
+		FileReport->SetNumberField(TEXT("StaticMeshes"), NumStaticMeshes);
+		FileReport->SetNumberField(TEXT("SkeletalMeshes"), NumSkeletalMeshes);
+		FileReport->SetNumberField(TEXT("Assets"), NumFileAssets);
+		if (bMemoryAccounting)
+		{
+			FileReport->SetNumberField(TEXT("ParsePeakBytes"), (double)File->DataDescription->GetMemoryAccounting()->GetTotalPeakBytes());
+		}
+		FileReports.Add(MakeShared<FJsonValueObject>(FileReport));
+
+		CsvLines.Add(FString::Printf(TEXT("\"%s\",%d,%f,%f,%f,%f,%f,%f,%f,%f,%f,%lld,%lld,%lld,%lld,%d,%d,%d"),
+			*File->FileName, bSucceeded ? 1 : 0,
+			ParseStats.ReadSeconds, ParseStats.ProcessTextSeconds - ParseStats.ProcessDataSeconds, ParseStats.ProcessDataSeconds,
+			FileTotals.Seconds[(int32)EOpenGEXImportPhase::ConvertMesh], FileTotals.Seconds[(int32)EOpenGEXImportPhase::CreateMaterial],
+			FileTotals.Seconds[(int32)EOpenGEXImportPhase::DecodeTexture], FileTotals.Seconds[(int32)EOpenGEXImportPhase::BuildMesh],
+			ImportSeconds, FileSaveSeconds,
+			ParseStats.Structures, ParseStats.BytesParsed,
+			FileTotals.Counts[(int32)EOpenGEXImportCounter::Vertices], FileTotals.Counts[(int32)EOpenGEXImportCounter::Triangles],
+			NumStaticMeshes, NumSkeletalMeshes, NumFileAssets));
+
+		UE_LOG(LogOpenGEXImporter, Display, TEXT("[%d/%d] %s: %d assets"), FileIndex + 1, Files.Num(), *BaseName, NumFileAssets);
+
+		// Releases the parsed data before the next file is imported.
+		File.Reset();
+	}
+
+	const double TotalSeconds = FPlatformTime::Seconds() - TotalStartTime;
+	UE_LOG(LogOpenGEXImporter, Display, TEXT("Imported %d files (%d failed), %d assets in %.2f seconds"), Files.Num(), NumFailedFiles, NumAssets, TotalSeconds);
+
+	if (!ReportFileName.IsEmpty())
+	{
+		TSharedRef<FJsonObject> Report = MakeShared<FJsonObject>();
+		Report->SetStringField(TEXT("Source"), Source);
+		Report->SetStringField(TEXT("Dest"), DestPath);
+		Report->SetNumberField(TEXT("Files"), Files.Num());
+		Report->SetNumberField(TEXT("FailedFiles"), NumFailedFiles);
+		Report->SetNumberField(TEXT("FailedPackages"), NumFailedPackages);
+		Report->SetNumberField(TEXT("Assets"), NumAssets);
+		Report->SetNumberField(TEXT("SaveSeconds"), SaveSeconds);
+		Report->SetNumberField(TEXT("TotalSeconds"), TotalSeconds);
+		AddOpenGEXPhaseFields(Report, FOpenGEXImportTotals::Get());
+		Report->SetArrayField(TEXT("FileReports"), FileReports);
+
+		FString ReportText;
+		TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&ReportText);
+		FJsonSerializer::Serialize(Report, Writer);
+
+		if (!FFileHelper::SaveStringToFile(ReportText, *ReportFileName))
+		{
+			UE_LOG(LogOpenGEXImporter, Error, TEXT("Failed to write report '%s'"), *ReportFileName);
+		}
+	}
+
+	if (!CsvFileName.IsEmpty() && !FFileHelper::SaveStringArrayToFile(CsvLines, *CsvFileName))
+	{
+		UE_LOG(LogOpenGEXImporter, Error, TEXT("Failed to write CSV '%s'"), *CsvFileName);
+	}
+
+	return (NumFailedFiles > 0 || NumFailedPackages > 0) ? 1 : 0;
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "Commandlets/Commandlet.h"
+
+#include "OpenGEXImportCommandlet.generated.h"
+
+/**
+ * Imports OpenGEX files without the editor UI, e.g. on a build agent:
+ *
+ * UE4Editor-Cmd Project.uproject -run=OpenGEXImport -Source=<Directory|Manifest.txt> -Dest=/Game/Imported
+ *     [-Report=<Report.json>] [-Csv=<Phases.csv>] [-SaveBatch=<Files>] [-MemoryAccounting] -nullrhi
+ *
+ * A manifest lists one .ogex path per line, relative to the manifest. Every file gets its own folder under Dest, at
+ * the same relative path as the file has below the source directory or the manifest.
+ * The CSV has one row per file with the parse, import and save wall times, the CPU seconds of each import phase summed
+ * over all threads, and the counters of the OpenGEXImporter stats group. In the JSON report, fields ending in CpuSeconds
+ * are exclusive phase times and add up, while the WallSeconds of the parse overlap them: ParseWallSeconds covers
+ * tokenizing and ProcessData.
+ * -MemoryAccounting logs the OpenDDL memory by structure type after each parse and reports the peak per file.
+ */
+UCLASS()
+class UOpenGEXImportCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UOpenGEXImportCommandlet(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
+
+	int32 Main(const FString& Params) override;
+};
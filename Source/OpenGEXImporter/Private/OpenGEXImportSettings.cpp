@@ -0,0 +1,25 @@
+#include "OpenGEXImportSettings.h"
+
+UOpenGEXImportSettings::UOpenGEXImportSettings(const FObjectInitializer& ObjectInitializer /*= FObjectInitializer::Get()*/)
+	: Super(ObjectInitializer)
+{
+	CategoryName = TEXT("Plugins");
+
+	MaterialImportMode = EOpenGEXMaterialImportMode::UniqueMaterials;
+	ParentMaterialName = TEXT("M_OpenGEX_Parent");
+
+	bReduceAnimationKeys = true;
+	AnimationPositionTolerance = 0.01f;
+	AnimationRotationTolerance = 0.05f;
+	AnimationScaleTolerance = 0.0001f;
+
+	MorphTargetPositionThreshold = THRESH_POINTS_ARE_NEAR;
+	MorphTargetNormalThreshold = 0.01f;
+
+	bCreateSceneBlueprint = false;
+
+	bMergeSmallNodes = false;
+	MergeNodeVertexLimit = 1000;
+	MergeCellSize = 5000.0f;
+	MergedMeshCornerBudget = 65536;
+}
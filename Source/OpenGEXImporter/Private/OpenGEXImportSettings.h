@@ -0,0 +1,86 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DeveloperSettings.h"
+
+#include "OpenGEXImportSettings.generated.h"
+
+UENUM()
+enum class EOpenGEXMaterialImportMode : uint8
+{
+	/** Build a standalone material with its own expression graph for every OpenGEX material. */
+	UniqueMaterials,
+
+	/** Create one shared parameterized parent material and a material instance for every OpenGEX material. */
+	MaterialInstances,
+};
+
+/**
+ * Per user options for importing OpenGEX files.
+ */
+UCLASS(config = EditorPerProjectUserSettings, meta = (DisplayName = "OpenGEX Import"))
+class UOpenGEXImportSettings : public UDeveloperSettings
+{
+	GENERATED_BODY()
+
+public:
+	UOpenGEXImportSettings(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
+
+	/** How OpenGEX materials are turned into assets. Material instances only compile the shaders of their parent. */
+	UPROPERTY(config, EditAnywhere, Category = Materials)
+	EOpenGEXMaterialImportMode MaterialImportMode;
+
+	/** Parent material asset created next to the imported assets and shared by all generated material instances. */
+	UPROPERTY(config, EditAnywhere, Category = Materials)
+	FString ParentMaterialName;
+
+	/** Drop animation keys that can be rebuilt by interpolation within the tolerances below. */
+	UPROPERTY(config, EditAnywhere, Category = Animation)
+	bool bReduceAnimationKeys;
+
+	/** Largest bone translation error, in imported units, that key reduction may introduce. */
+	UPROPERTY(config, EditAnywhere, Category = Animation, meta = (ClampMin = "0.0", EditCondition = "bReduceAnimationKeys"))
+	float AnimationPositionTolerance;
+
+	/** Largest bone rotation error, in degrees, that key reduction may introduce. */
+	UPROPERTY(config, EditAnywhere, Category = Animation, meta = (ClampMin = "0.0", EditCondition = "bReduceAnimationKeys"))
+	float AnimationRotationTolerance;
+
+	/** Largest bone scale error that key reduction may introduce. */
+	UPROPERTY(config, EditAnywhere, Category = Animation, meta = (ClampMin = "0.0", EditCondition = "bReduceAnimationKeys"))
+	float AnimationScaleTolerance;
+
+	/** Morph target vertices that move less than this along every axis, in the file's units, are left out of the morph target. */
+	UPROPERTY(config, EditAnywhere, Category = MorphTargets, meta = (ClampMin = "0.0"))
+	float MorphTargetPositionThreshold;
+
+	/** Morph target vertices whose normal changes less than this along every axis are left out, unless their position moves. */
+	UPROPERTY(config, EditAnywhere, Category = MorphTargets, meta = (ClampMin = "0.0"))
+	float MorphTargetNormalThreshold;
+
+	/**
+	 * Also create a Blueprint that places every static mesh at its node's transform. Nodes with the same geometry and
+	 * materials then share one mesh asset and become instances of a hierarchical instanced static mesh component.
+	 */
+	UPROPERTY(config, EditAnywhere, Category = Scene)
+	bool bCreateSceneBlueprint;
+
+	/**
+	 * Bake the transforms of small unskinned geometry nodes into their vertices and merge them into one static mesh per
+	 * material and grid cell, which saves a draw call and an actor per node. Merged nodes lose their separate LODs.
+	 */
+	UPROPERTY(config, EditAnywhere, Category = Merging)
+	bool bMergeSmallNodes;
+
+	/** Nodes whose base mesh has at most this many vertices get merged. */
+	UPROPERTY(config, EditAnywhere, Category = Merging, meta = (ClampMin = "1", EditCondition = "bMergeSmallNodes"))
+	int32 MergeNodeVertexLimit;
+
+	/** Edge length of the grid cells nodes are grouped by, so each merged mesh stays local enough to be culled. Nodes fall into the cell of their origin. */
+	UPROPERTY(config, EditAnywhere, Category = Merging, meta = (ClampMin = "1.0", EditCondition = "bMergeSmallNodes"))
+	float MergeCellSize;
+
+	/** Largest number of triangle corners in one merged mesh. A group that would exceed it is split over several meshes. */
+	UPROPERTY(config, EditAnywhere, Category = Merging, meta = (ClampMin = "3", EditCondition = "bMergeSmallNodes"))
+	int32 MergedMeshCornerBudget;
+};
@@ -1,5 +1,6 @@
 #include "OpenGEXImporterFactory.h"
 
+#include "Async/ParallelFor.h"
 #include "Misc/FeedbackContext.h"
 #include "Misc/FileHelper.h"
 #include "Misc/Paths.h"
@@ -10,41 +11,124 @@
 #include "OpenGEX.h"
 #include "OpenGEXUtility.h"
 #include "OpenGEXStaticMesh.h"
+#include "OpenGEXSkeletalMesh.h"
 #include "OpenGEXMaterial.h"
+#include "OpenGEXScene.h"
+#include "OpenGEXImportSettings.h"
+#include "OpenGEXCommons.h"
 
-UStaticMesh* ImportMeshesAndMaterialsFromOpenGEXFile(const FString& FileName, UObject* InParent, FName InName, EObjectFlags Flags, FFeedbackContext* Warn)
+DataResult FOpenGEXInstrumentedDataDescription::ProcessData(void)
 {
-	UStaticMesh* StaticMesh = nullptr;
+	const double StartTime = FPlatformTime::Seconds();
+	OPENGEX_IMPORT_SCOPE(ProcessData);
 
-	IPlatformFile& PlatformPhysicalFile = IPlatformFile::GetPlatformPhysical();
-	IFileHandle* FileHandle = PlatformPhysicalFile.OpenRead(*FileName);
-	if (FileHandle)
+	DataResult Result = OGEX::OpenGexDataDescription::ProcessData();
+	ParseStats.ProcessDataSeconds = FPlatformTime::Seconds() - StartTime;
+
+	return Result;
+}
+
+void FOpenGEXInstrumentedDataDescription::DumpMemoryAccounting(const MemoryAccounting* Accounting)
+{
+	const ODDL::String Summary = Accounting->GetSummary();
+	UE_LOG(LogOpenGEXImporter, Log, TEXT("OpenDDL memory by structure type:\n%s"), UTF8_TO_TCHAR((const char*)Summary));
+}
+
+void FOpenGEXInstrumentedDataDescription::RunParallelJobs(int32 JobCount, ParallelJobProc* Proc, void* Cookie)
+{
+	ParallelFor(JobCount, [Proc, Cookie](int32 JobIndex)
 	{
-		int32 FileSize = FileHandle->Size();
-		TArray<char> Buffer;
-		Buffer.SetNumZeroed(FileSize + 1);
+		(*Proc)(JobIndex, Cookie);
+	});
+}
+
+bool ParseOpenGEXFile(const FString& FileName, FOpenGEXInstrumentedDataDescription& OutDataDescription)
+{
+	bool bParsed = false;
 
-		if (FileHandle->Read((uint8*)Buffer.GetData(), FileSize))
+	TArray<char> Buffer;
+	{
+		const double StartTime = FPlatformTime::Seconds();
+		OPENGEX_IMPORT_SCOPE(ReadFile);
+
+		IPlatformFile& PlatformPhysicalFile = IPlatformFile::GetPlatformPhysical();
+		IFileHandle* FileHandle = PlatformPhysicalFile.OpenRead(*FileName);
+		if (FileHandle)
 		{
-			OGEX::OpenGexDataDescription openGexDataDescription;
-			openGexDataDescription.ProcessText(Buffer.GetData());
+			int32 FileSize = FileHandle->Size();
+			Buffer.SetNumZeroed(FileSize + 1);
 
-			TMap<FName, UMaterial*> Materials = ImportMaterialsFromOpenGEX(&openGexDataDescription, InParent, FileName, InName, Flags);
-			TArray<UStaticMesh*> StaticMeshes = ImportMeshesFromOpenGEX(&openGexDataDescription, Materials, FileName, InParent, InName, Flags, Warn);
-			if (StaticMeshes.Num() > 0)
+			if (!FileHandle->Read((uint8*)Buffer.GetData(), FileSize))
 			{
-				StaticMesh = StaticMeshes[0];
+				Buffer.Empty();
 			}
+
+			delete FileHandle;
+			FileHandle = nullptr;
 		}
+
+		OutDataDescription.ParseStats.ReadSeconds = FPlatformTime::Seconds() - StartTime;
+	}
+
+	if (Buffer.Num() > 0)
+	{
+		const double StartTime = FPlatformTime::Seconds();
+		OPENGEX_IMPORT_SCOPE(ProcessText);
+
+		bParsed = (OutDataDescription.ProcessText(Buffer.GetData()) == ODDL::kDataOkay);
+
+		// ProcessText includes ProcessData, the difference is the tokenizer.
+		OutDataDescription.ParseStats.ProcessTextSeconds = FPlatformTime::Seconds() - StartTime;
+		OutDataDescription.ParseStats.BytesParsed = Buffer.Num() - 1;
+		OutDataDescription.ParseStats.Structures = OutDataDescription.GetStructureCount();
+		OPENGEX_IMPORT_COUNT(BytesParsed, Buffer.Num() - 1);
+		OPENGEX_IMPORT_COUNT(Structures, OutDataDescription.GetStructureCount());
 	}
 
-	if (FileHandle)
+	return bParsed;
+}
+
+TArray<UObject*> ImportMeshesAndMaterialsFromOpenGEX(OGEX::OpenGexDataDescription* OpenGexDataDescriptionPtr, const FString& FileName, UObject* InParent, FName InName, EObjectFlags Flags, FFeedbackContext* Warn)
+{
+	FOpenGEXAssetNameCache AssetNameCache(InParent);
+
+	FOpenGEXMaterialImporter MaterialImporter(OpenGexDataDescriptionPtr, InParent, FileName, InName, Flags, AssetNameCache);
+
+	const bool bCreateSceneBlueprint = GetDefault<UOpenGEXImportSettings>()->bCreateSceneBlueprint;
+	TMap<OGEX::GeometryNodeStructure*, UStaticMesh*> NodeMeshes;
+	TArray<UStaticMesh*> MergedMeshes;
+
+	TArray<UObject*> Meshes;
+	Meshes.Append(ImportMeshesFromOpenGEX(OpenGexDataDescriptionPtr, MaterialImporter, AssetNameCache, FileName, InParent, InName, Flags, Warn, bCreateSceneBlueprint, &NodeMeshes, &MergedMeshes));
+	Meshes.Append(ImportSkeletalMeshesFromOpenGEX(OpenGexDataDescriptionPtr, MaterialImporter, AssetNameCache, FileName, InParent, InName, Flags, Warn));
+
+	if (bCreateSceneBlueprint)
+	{
+		ImportSceneBlueprintFromOpenGEX(OpenGexDataDescriptionPtr, NodeMeshes, MergedMeshes, FileName, InParent, InName, Flags, AssetNameCache);
+	}
+
+	return Meshes;
+}
+
+UObject* ImportMeshesAndMaterialsFromOpenGEXFile(const FString& FileName, UObject* InParent, FName InName, EObjectFlags Flags, FFeedbackContext* Warn)
+{
+	UObject* Mesh = nullptr;
+
+	FOpenGEXInstrumentedDataDescription openGexDataDescription;
+	if (ParseOpenGEXFile(FileName, openGexDataDescription))
+	{
+		TArray<UObject*> Meshes = ImportMeshesAndMaterialsFromOpenGEX(&openGexDataDescription, FileName, InParent, InName, Flags, Warn);
+		if (Meshes.Num() > 0)
+		{
+			Mesh = Meshes[0];
+		}
+	}
+	else
 	{
-		delete FileHandle;
-		FileHandle = nullptr;
+		UE_LOG(LogOpenGEXImporter, Error, TEXT("Failed to parse OpenGEX file '%s'"), *FileName);
 	}
 
-	return StaticMesh;
+	return Mesh;
 }
 
 UOpenGEXImporterFactory::UOpenGEXImporterFactory(const FObjectInitializer& ObjectInitializer /*= FObjectInitializer::Get()*/)
@@ -62,17 +146,17 @@ UOpenGEXImporterFactory::UOpenGEXImporterFactory(const FObjectInitializer& Objec
 
 UObject* UOpenGEXImporterFactory::FactoryCreateFile(UClass* InClass, UObject* InParent, FName InName, EObjectFlags Flags, const FString& Filename, const TCHAR* Parms, FFeedbackContext* Warn, bool& bOutOperationCanceled)
 {
-	UStaticMesh* StaticMesh = nullptr;
+	UObject* Mesh = nullptr;
 
 	FEditorDelegates::OnAssetPreImport.Broadcast(this, InClass, InParent, InName, Parms);
 
 	Warn->Log(Filename);
 
-	StaticMesh = ImportMeshesAndMaterialsFromOpenGEXFile(Filename, InParent, InName, Flags, Warn);
+	Mesh = ImportMeshesAndMaterialsFromOpenGEXFile(Filename, InParent, InName, Flags, Warn);
 
-	FEditorDelegates::OnAssetPostImport.Broadcast(this, StaticMesh);
+	FEditorDelegates::OnAssetPostImport.Broadcast(this, Mesh);
 
-	return StaticMesh;
+	return Mesh;
 }
 
 bool UOpenGEXImporterFactory::FactoryCanImport(const FString& Filename)
@@ -1,9 +1,43 @@
 #pragma once
 
 #include "Factories/Factory.h"
+#include "OpenGEX.h"
 
 #include "OpenGEXImporterFactory.generated.h"
 
+class UStaticMesh;
+
+struct FOpenGEXParseStats
+{
+	double ReadSeconds = 0.0;
+	double ProcessTextSeconds = 0.0;
+	double ProcessDataSeconds = 0.0;
+	int64 Structures = 0;
+	int64 BytesParsed = 0;
+};
+
+// Keeps the parse timings and sizes of one file, since files may be parsed concurrently.
+// Parse-time jobs of the library, such as skin offset tables, run on the task graph.
+class FOpenGEXInstrumentedDataDescription : public OGEX::OpenGexDataDescription
+{
+public:
+	FOpenGEXParseStats ParseStats;
+
+	void RunParallelJobs(int32 JobCount, ParallelJobProc* Proc, void* Cookie) override;
+
+protected:
+	DataResult ProcessData(void) override;
+	void DumpMemoryAccounting(const MemoryAccounting* Accounting) override;
+};
+
+// Reads and parses an OpenGEX file. Touches no UObjects, so it may run on any thread.
+bool ParseOpenGEXFile(const FString& FileName, FOpenGEXInstrumentedDataDescription& OutDataDescription);
+
+// Creates the assets of an already parsed file and returns its static meshes followed by its skeletal meshes. Must run on the game thread.
+TArray<UObject*> ImportMeshesAndMaterialsFromOpenGEX(OGEX::OpenGexDataDescription* OpenGexDataDescriptionPtr, const FString& FileName, UObject* InParent, FName InName, EObjectFlags Flags, FFeedbackContext* Warn);
+
+UObject* ImportMeshesAndMaterialsFromOpenGEXFile(const FString& FileName, UObject* InParent, FName InName, EObjectFlags Flags, FFeedbackContext* Warn);
+
 UCLASS(Transient)
 class UOpenGEXImporterFactory : public UFactory
 {
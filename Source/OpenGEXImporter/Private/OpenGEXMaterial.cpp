@@ -6,12 +6,21 @@
 #include "Materials/MaterialExpressionConstant3Vector.h"
 #include "Materials/MaterialExpressionConstant4Vector.h"
 #include "Materials/MaterialExpressionMultiply.h"
+#include "Materials/MaterialExpressionScalarParameter.h"
+#include "Materials/MaterialExpressionVectorParameter.h"
+#include "Materials/MaterialExpressionTextureSampleParameter2D.h"
+#include "Materials/MaterialInstanceConstant.h"
 #include "Factories/TextureFactory.h"
 #include "Engine/Texture2D.h"
 #include "AssetRegistryModule.h"
 #include "EditorFramework/AssetImportData.h"
 #include "OpenGEXUtility.h"
 #include "FileHelper.h"
+#include "IImageWrapper.h"
+#include "IImageWrapperModule.h"
+#include "Async/ParallelFor.h"
+#include "OpenGEXImportSettings.h"
+#include "OpenGEXAssetImportData.h"
 
 static constexpr int32 GridSnap = 16;
 
@@ -69,43 +78,236 @@ static void ConnectInput(UMaterial* Material, FExpressionInput& MaterialInput, U
 	// Add Texture & Factor to Material->Expressions in this func? If so use AddUnique for Texture.
 }
 
-UTexture2D* ImportTextureFromOpenGEXTexture(OGEX::TextureStructure* TextureStruct, int32 Index, UObject* InParent, const FString& FileName, FName InName, EObjectFlags Flags)
+/** Color space, LOD group and compression of a texture, as decided by what materials sample it for. */
+struct FOpenGEXTextureUsageSettings
+{
+	bool bSRGB;
+	TextureGroup LODGroup;
+	TextureCompressionSettings CompressionSettings;
+};
+
+static FOpenGEXTextureUsageSettings GetTextureUsageSettings(EOpenGEXTextureUsage Usage)
+{
+	if (Usage == EOpenGEXTextureUsage::Normal)
+	{
+		return { false, TEXTUREGROUP_WorldNormalMap, TC_Normalmap };
+	}
+
+	return { true, TEXTUREGROUP_World, TC_Default };
+}
+
+// Has to run before the texture is built, changing these afterwards only takes effect once the asset is rebuilt.
+// Returns whether any setting changed.
+static bool ApplyTextureUsageSettings(UTexture2D* Texture, EOpenGEXTextureUsage Usage)
+{
+	const FOpenGEXTextureUsageSettings Settings = GetTextureUsageSettings(Usage);
+	const bool bChanged = (Texture->SRGB != Settings.bSRGB) || (Texture->LODGroup != Settings.LODGroup) || (Texture->CompressionSettings != Settings.CompressionSettings) || Texture->bFlipGreenChannel;
+
+	Texture->SRGB = Settings.bSRGB;
+	Texture->LODGroup = Settings.LODGroup;
+	Texture->CompressionSettings = Settings.CompressionSettings;
+	Texture->bFlipGreenChannel = false;
+
+	return bChanged;
+}
+
+static EOpenGEXTextureUsage GetTextureUsageForOpenGEX(OGEX::TextureStructure* TextureStruct)
+{
+	return (TextureStruct->GetAttribString() == "normal") ? EOpenGEXTextureUsage::Normal : EOpenGEXTextureUsage::Color;
+}
+
+// Parameters exposed by the shared parent material.
+static const FName DiffuseColorParameterName(TEXT("DiffuseColor"));
+static const FName DiffuseTextureParameterName(TEXT("DiffuseTexture"));
+static const FName NormalTextureParameterName(TEXT("NormalTexture"));
+static const FName SpecularParameterName(TEXT("Specular"));
+static const FName RoughnessParameterName(TEXT("Roughness"));
+static const FName EmissiveColorParameterName(TEXT("EmissiveColor"));
+
+static FString ResolveTextureFilenameForOpenGEX(OGEX::TextureStructure* TextureStruct, const FString& FileName)
+{
+	FString TextureFileCleanName = FPaths::GetCleanFilename(UTF8_TO_TCHAR(TextureStruct->GetTextureName()));
+
+	FString TextureFilename = FPaths::ConvertRelativePathToFull(FPaths::GetPath(FileName) / TextureFileCleanName);
+	FPaths::NormalizeFilename(TextureFilename);
+
+	return TextureFilename;
+}
+
+// Reads, hashes and decodes one texture file. Touches no UObjects, so it may run on any thread.
+static void LoadTextureSourceForOpenGEX(const FString& TextureFilename, IImageWrapperModule& ImageWrapperModule, FOpenGEXTextureSource& OutSource)
+{
+	OPENGEX_IMPORT_SCOPE(DecodeTexture);
+
+	if (!FFileHelper::LoadFileToArray(OutSource.FileData, *TextureFilename, FILEREAD_Silent))
+		return;
+
+	OutSource.bLoaded = true;
+	FSHA1::HashBuffer(OutSource.FileData.GetData(), OutSource.FileData.Num(), OutSource.Hash.Hash);
+
+	// Only plain 8-bit formats are decoded up front. TGA, HDR, EXR and anything else keep going through UTextureFactory.
+	EImageFormat ImageFormat = ImageWrapperModule.DetectImageFormat(OutSource.FileData.GetData(), OutSource.FileData.Num());
+	if (ImageFormat != EImageFormat::PNG && ImageFormat != EImageFormat::JPEG && ImageFormat != EImageFormat::BMP)
+		return;
+
+	TSharedPtr<IImageWrapper> ImageWrapper = ImageWrapperModule.CreateImageWrapper(ImageFormat);
+	const TArray<uint8>* RawData = nullptr;
+	if (ImageWrapper.IsValid() && ImageWrapper->SetCompressed(OutSource.FileData.GetData(), OutSource.FileData.Num()) && ImageWrapper->GetRaw(ERGBFormat::BGRA, 8, RawData))
+	{
+		OutSource.Width = ImageWrapper->GetWidth();
+		OutSource.Height = ImageWrapper->GetHeight();
+		OutSource.RawData = *RawData;
+		OutSource.FileData.Empty();
+	}
+}
+
+static void PreloadTexturesFromOpenGEX(const TArray<OGEX::MaterialStructure*>& MaterialStructs, const FString& FileName, FOpenGEXTextureCache& TextureCache)
+{
+	TArray<FString> TextureFilenames;
+	TSet<FString> SeenTextureFilenames;
+
+	for (OGEX::MaterialStructure* MaterialStruct : MaterialStructs)
+	{
+		Array<OGEX::AttribStructure*>& AttribStructures = MaterialStruct->GetAttribStructures();
+		for (int32 i = 0; i < AttribStructures.GetElementCount(); ++i)
+		{
+			if (AttribStructures[i]->GetStructureType() == OGEX::kStructureTexture)
+			{
+				OGEX::TextureStructure* TextureStruct = static_cast<OGEX::TextureStructure*>(AttribStructures[i]);
+				FString TextureFilename = ResolveTextureFilenameForOpenGEX(TextureStruct, FileName);
+				if (TextureCache.Sources.Contains(TextureFilename))
+					continue;
+
+				bool bAlreadySeen = false;
+				SeenTextureFilenames.Add(TextureFilename, &bAlreadySeen);
+				if (!bAlreadySeen)
+				{
+					TextureFilenames.Add(MoveTemp(TextureFilename));
+				}
+			}
+		}
+	}
+
+	if (TextureFilenames.Num() == 0)
+		return;
+
+	// Modules have to be loaded on the game thread, the wrappers themselves are fine to use from workers.
+	IImageWrapperModule& ImageWrapperModule = FModuleManager::LoadModuleChecked<IImageWrapperModule>(FName("ImageWrapper"));
+
+	TArray<FOpenGEXTextureSource> Sources;
+	Sources.SetNum(TextureFilenames.Num());
+	ParallelFor(TextureFilenames.Num(), [&](int32 SourceIndex)
+	{
+		LoadTextureSourceForOpenGEX(TextureFilenames[SourceIndex], ImageWrapperModule, Sources[SourceIndex]);
+	});
+
+	for (int32 SourceIndex = 0; SourceIndex < TextureFilenames.Num(); ++SourceIndex)
+	{
+		TextureCache.Sources.Add(TextureFilenames[SourceIndex], MoveTemp(Sources[SourceIndex]));
+	}
+}
+
+// Returns the source of a texture file, reading it on the game thread if it was not preloaded. The reference is only
+// valid until the next source gets added.
+static const FOpenGEXTextureSource& FindOrLoadTextureSourceForOpenGEX(const FString& TextureFilename, FOpenGEXTextureCache& TextureCache)
+{
+	if (const FOpenGEXTextureSource* Source = TextureCache.Sources.Find(TextureFilename))
+	{
+		return *Source;
+	}
+
+	IImageWrapperModule& ImageWrapperModule = FModuleManager::LoadModuleChecked<IImageWrapperModule>(FName("ImageWrapper"));
+
+	FOpenGEXTextureSource& Source = TextureCache.Sources.Add(TextureFilename);
+	LoadTextureSourceForOpenGEX(TextureFilename, ImageWrapperModule, Source);
+	return Source;
+}
+
+UTexture2D* ImportTextureFromOpenGEXTexture(OGEX::TextureStructure* TextureStruct, int32 Index, UObject* InParent, const FString& FileName, FName InName, EObjectFlags Flags, FOpenGEXTextureCache& TextureCache, FOpenGEXAssetNameCache& NameCache)
 {
 	UTexture2D* Texture = nullptr;
 
 	FString TextureFileCleanName = FPaths::GetCleanFilename(UTF8_TO_TCHAR(TextureStruct->GetTextureName()));
 	FString Extension = FPaths::GetExtension(TextureFileCleanName);
 
-	FString TextureFilename = FPaths::GetPath(FileName) + TEXT("/") + TextureFileCleanName;
+	FString TextureFilename = ResolveTextureFilenameForOpenGEX(TextureStruct, FileName);
+
+	// An image used both as a color and as a normal map becomes two textures with their own settings.
+	const EOpenGEXTextureUsage Usage = GetTextureUsageForOpenGEX(TextureStruct);
+	TMap<FString, UTexture2D*>& TexturesByPath = TextureCache.TexturesByPath[(int32)Usage];
+	TMap<FSHAHash, UTexture2D*>& TexturesByHash = TextureCache.TexturesByHash[(int32)Usage];
 
-	TArray<uint8> ImageData;
-	if (!FFileHelper::LoadFileToArray(ImageData, *TextureFilename))
+	if (UTexture2D** CachedTexture = TexturesByPath.Find(TextureFilename))
+	{
+		return *CachedTexture;
+	}
+
+	const FString TextureAssetName = (Usage == EOpenGEXTextureUsage::Normal) ? FPaths::GetBaseFilename(TextureFileCleanName) + TEXT("_Normal") : TextureFileCleanName;
+
+	const FOpenGEXTextureSource& Source = FindOrLoadTextureSourceForOpenGEX(TextureFilename, TextureCache);
+
+	if (!Source.bLoaded)
 	{
 		UE_LOG(LogOpenGEXImporter, Error, TEXT("Failed to load file '%s' to array"), *TextureFilename);
+		TexturesByPath.Add(TextureFilename, nullptr);
 		return nullptr;
 	}
 
-	if (ImageData.Num() > 0)
+	if (UTexture2D** CachedTexture = TexturesByHash.Find(Source.Hash))
+	{
+		TexturesByPath.Add(TextureFilename, *CachedTexture);
+		return *CachedTexture;
+	}
+
+	if (Source.RawData.Num() > 0)
+	{
+		FString AssetName;
+		UPackage* AssetPackage = RetrieveAssetPackageAndName<UTexture2D>(NameCache, InParent, TextureAssetName, TEXT("T"), InName, Index, AssetName);
+
+		Texture = NewObject<UTexture2D>(AssetPackage, FName(*AssetName), Flags);
+		Texture->Source.Init(Source.Width, Source.Height, 1, 1, TSF_BGRA8, Source.RawData.GetData());
+		Texture->AssetImportData->Update(*TextureFileCleanName);
+		ApplyTextureUsageSettings(Texture, Usage);
+		Texture->PostEditChange();
+
+		FAssetRegistryModule::AssetCreated(Texture);
+
+		AssetPackage->SetDirtyFlag(true);
+	}
+	else if (Source.FileData.Num() > 0)
 	{
-		const uint8* ImageDataPtr = &ImageData[0];
+		const uint8* ImageDataPtr = &Source.FileData[0];
 
 		FString AssetName;
-		UPackage* AssetPackage = RetrieveAssetPackageAndName<UTexture2D>(InParent, TextureFileCleanName, TEXT("T"), InName, Index, AssetName);
+		UPackage* AssetPackage = RetrieveAssetPackageAndName<UTexture2D>(NameCache, InParent, TextureAssetName, TEXT("T"), InName, Index, AssetName);
 
 		auto Factory = NewObject<UTextureFactory>();
 		Factory->AddToRoot();
 
 		Factory->SuppressImportOverwriteDialog();
 
+		// The factory builds the texture itself, so it has to start out with the usage settings to only build it once.
+		const FOpenGEXTextureUsageSettings UsageSettings = GetTextureUsageSettings(Usage);
+		Factory->LODGroup = UsageSettings.LODGroup;
+		Factory->CompressionSettings = UsageSettings.CompressionSettings;
+		Factory->bFlipNormalMapGreenChannel = false;
+
 		Texture = (UTexture2D*)Factory->FactoryCreateBinary(
 			UTexture2D::StaticClass(), AssetPackage, *AssetName,
 			Flags, nullptr, *Extension,
-			ImageDataPtr, ImageDataPtr + ImageData.Num(), GWarn);
+			ImageDataPtr, ImageDataPtr + Source.FileData.Num(), GWarn);
 
 		if (Texture != nullptr)
 		{
 			Texture->AssetImportData->Update(*TextureFileCleanName);
 
+			// The factory picks sRGB from the image format and keeps the settings of a texture it imports over, so
+			// only a mismatch left by either of those costs a second build.
+			if (ApplyTextureUsageSettings(Texture, Usage))
+			{
+				Texture->PostEditChange();
+			}
+
 			FAssetRegistryModule::AssetCreated(Texture);
 
 			AssetPackage->SetDirtyFlag(true);
@@ -114,10 +316,16 @@ UTexture2D* ImportTextureFromOpenGEXTexture(OGEX::TextureStructure* TextureStruc
 		Factory->RemoveFromRoot();
 	}
 
+	TexturesByPath.Add(TextureFilename, Texture);
+	if (Texture)
+	{
+		TexturesByHash.Add(Source.Hash, Texture);
+	}
+
 	return Texture;
 }
 
-TMap<FName, UTexture2D*> ImportTexturesFromOpenGEX(OGEX::MaterialStructure* MaterialStruct, UObject* InParent, const FString& FileName, FName InName, EObjectFlags Flags)
+TMap<FName, UTexture2D*> ImportTexturesFromOpenGEX(OGEX::MaterialStructure* MaterialStruct, UObject* InParent, const FString& FileName, FName InName, EObjectFlags Flags, FOpenGEXTextureCache& TextureCache, FOpenGEXAssetNameCache& NameCache)
 {
 	TMap<FName, UTexture2D*> Textures;
 
@@ -131,7 +339,7 @@ TMap<FName, UTexture2D*> ImportTexturesFromOpenGEX(OGEX::MaterialStructure* Mate
 		{
 			Index += 1;
 			OGEX::TextureStructure* TextureStruct = static_cast<OGEX::TextureStructure*>(AttribStruct);
-			UTexture2D* UnTex = ImportTextureFromOpenGEXTexture(TextureStruct, Index, InParent, FileName, InName, Flags);
+			UTexture2D* UnTex = ImportTextureFromOpenGEXTexture(TextureStruct, Index, InParent, FileName, InName, Flags, TextureCache, NameCache);
 			if (UnTex)
 			{
 				Textures.Add(FName(UTF8_TO_TCHAR(TextureStruct->GetAttribString())), UnTex);
@@ -142,14 +350,20 @@ TMap<FName, UTexture2D*> ImportTexturesFromOpenGEX(OGEX::MaterialStructure* Mate
 	return Textures;
 }
 
-UMaterial* ImportMaterialFromOpenGEX(OGEX::MaterialStructure* MaterialStruct, int32 Index, UObject* InParent, const FString& FileName, FName InName, EObjectFlags Flags)
+UMaterial* ImportMaterialFromOpenGEX(OGEX::MaterialStructure* MaterialStruct, int32 Index, UObject* InParent, const FString& FileName, FName InName, EObjectFlags Flags, FOpenGEXTextureCache& TextureCache, FOpenGEXAssetNameCache& NameCache, const FString& ContentHash)
 {
-	TMap<FName, UTexture2D*> Textures = ImportTexturesFromOpenGEX(MaterialStruct, InParent, FileName, InName, Flags);
-
 	FString AssetName;
-	UPackage* AssetPackage = RetrieveAssetPackageAndName<UMaterial>(InParent, UTF8_TO_TCHAR(MaterialStruct->GetMaterialName()), TEXT("M"), InName, Index, AssetName);
+	UPackage* AssetPackage = RetrieveAssetPackageAndName<UMaterial>(NameCache, InParent, UTF8_TO_TCHAR(MaterialStruct->GetMaterialName()), TEXT("M"), InName, Index, AssetName);
+
+	if (UMaterial* UnchangedMaterial = FindUnchangedOpenGEXAsset<UMaterial>(AssetPackage, AssetName, ContentHash))
+	{
+		return UnchangedMaterial;
+	}
+
+	TMap<FName, UTexture2D*> Textures = ImportTexturesFromOpenGEX(MaterialStruct, InParent, FileName, InName, Flags, TextureCache, NameCache);
 
 	UMaterial* Material = NewObject<UMaterial>(AssetPackage, UMaterial::StaticClass(), FName(*AssetName), Flags);
+	Material->AssetImportData = UOpenGEXAssetImportData::Create(Material, FileName, ContentHash);
 
 	UMaterialExpressionConstant3Vector* BaseColorFactorNode = nullptr;
 	UMaterialExpressionTextureSample* BaseColorSamplerNode = nullptr;
@@ -178,9 +392,6 @@ UMaterial* ImportMaterialFromOpenGEX(OGEX::MaterialStructure* MaterialStruct, in
 				if (TexturePtr)
 				{
 					UTexture2D* Texture = *TexturePtr;
-					Texture->SRGB = true;
-					Texture->LODGroup = TEXTUREGROUP_World;
-					Texture->CompressionSettings = TC_Default;
 
 					BaseColorSamplerNode = NewObject<UMaterialExpressionTextureSample>(Material);
 					BaseColorSamplerNode->Texture = Texture;
@@ -196,10 +407,6 @@ UMaterial* ImportMaterialFromOpenGEX(OGEX::MaterialStructure* MaterialStruct, in
 				if (TexturePtr)
 				{
 					UTexture2D* Texture = *TexturePtr;
-					Texture->SRGB = false;
-					Texture->LODGroup = TEXTUREGROUP_WorldNormalMap;
-					Texture->bFlipGreenChannel = false;
-					Texture->CompressionSettings = TC_Normalmap;
 
 					UMaterialExpressionTextureSample* NormalSamplerNode = NewObject<UMaterialExpressionTextureSample>(Material);
 					NormalSamplerNode->Texture = Texture;
@@ -219,27 +426,287 @@ UMaterial* ImportMaterialFromOpenGEX(OGEX::MaterialStructure* MaterialStruct, in
 	return Material;
 }
 
-TMap<FName, UMaterial*> ImportMaterialsFromOpenGEX(OGEX::OpenGexDataDescription* OpenGexDataDescriptionPtr, UObject* InParent, const FString& FileName, FName InName, EObjectFlags Flags)
+// Every parameter defaults to a neutral value, so instances only override what their OpenGEX material specifies.
+// The graph has no static switches and thus compiles a single set of shaders for all instances.
+static UMaterial* GetOrCreateParentMaterialForOpenGEX(UObject* InParent, EObjectFlags Flags, FOpenGEXAssetNameCache& NameCache)
 {
-	TMap<FName, UMaterial*> Materials;
+	const UOpenGEXImportSettings* ImportSettings = GetDefault<UOpenGEXImportSettings>();
 
-	int32 Index = 0;
+	// An existing parent material is kept as it is, since it may have been edited and other imports' instances share it.
+	FString MaterialName;
+	UPackage* AssetPackage = RetrieveAssetPackageAndName<UMaterial>(NameCache, InParent, ImportSettings->ParentMaterialName, TEXT("M"), FName(TEXT("OpenGEXParent")), 0, MaterialName);
+
+	UMaterial* Material = FindObject<UMaterial>(AssetPackage, *MaterialName);
+	if (Material)
+	{
+		return Material;
+	}
+
+	Material = NewObject<UMaterial>(AssetPackage, UMaterial::StaticClass(), FName(*MaterialName), Flags);
+
+	UMaterialExpressionVectorParameter* DiffuseColorNode = NewObject<UMaterialExpressionVectorParameter>(Material);
+	DiffuseColorNode->ParameterName = DiffuseColorParameterName;
+	DiffuseColorNode->DefaultValue = FLinearColor::White;
+	Material->Expressions.Add(DiffuseColorNode);
+	PlaceOnGrid(DiffuseColorNode, -25, -15);
+
+	UMaterialExpressionTextureSampleParameter2D* DiffuseTextureNode = NewObject<UMaterialExpressionTextureSampleParameter2D>(Material);
+	DiffuseTextureNode->ParameterName = DiffuseTextureParameterName;
+	DiffuseTextureNode->Texture = LoadObject<UTexture2D>(nullptr, TEXT("/Engine/EngineResources/WhiteSquareTexture.WhiteSquareTexture"));
+	DiffuseTextureNode->SamplerType = SAMPLERTYPE_Color;
+	Material->Expressions.Add(DiffuseTextureNode);
+	PlaceOnGrid(DiffuseTextureNode, -40, -14);
+
+	UMaterialExpressionTextureSampleParameter2D* NormalTextureNode = NewObject<UMaterialExpressionTextureSampleParameter2D>(Material);
+	NormalTextureNode->ParameterName = NormalTextureParameterName;
+	NormalTextureNode->Texture = LoadObject<UTexture2D>(nullptr, TEXT("/Engine/EngineMaterials/DefaultNormal.DefaultNormal"));
+	NormalTextureNode->SamplerType = SAMPLERTYPE_Normal;
+	Material->Expressions.Add(NormalTextureNode);
+	PlaceOnGrid(NormalTextureNode, -21, 38);
+
+	UMaterialExpressionScalarParameter* SpecularNode = NewObject<UMaterialExpressionScalarParameter>(Material);
+	SpecularNode->ParameterName = SpecularParameterName;
+	SpecularNode->DefaultValue = 0.5f;
+	Material->Expressions.Add(SpecularNode);
+	PlaceOnGrid(SpecularNode, -21, 4);
+
+	UMaterialExpressionScalarParameter* RoughnessNode = NewObject<UMaterialExpressionScalarParameter>(Material);
+	RoughnessNode->ParameterName = RoughnessParameterName;
+	RoughnessNode->DefaultValue = 0.5f;
+	Material->Expressions.Add(RoughnessNode);
+	PlaceOnGrid(RoughnessNode, -21, 12);
+
+	UMaterialExpressionVectorParameter* EmissiveColorNode = NewObject<UMaterialExpressionVectorParameter>(Material);
+	EmissiveColorNode->ParameterName = EmissiveColorParameterName;
+	EmissiveColorNode->DefaultValue = FLinearColor::Black;
+	Material->Expressions.Add(EmissiveColorNode);
+	PlaceOnGrid(EmissiveColorNode, -21, 20);
+
+	ConnectInput(Material, Material->BaseColor, DiffuseColorNode, DiffuseTextureNode);
+	ConnectInput(Material, Material->Normal, nullptr, NormalTextureNode);
+	ConnectInput(Material, Material->Specular, SpecularNode, nullptr);
+	ConnectInput(Material, Material->Roughness, RoughnessNode, nullptr);
+	ConnectInput(Material, Material->EmissiveColor, EmissiveColorNode, nullptr);
+
+	Material->PostEditChange();
+
+	FAssetRegistryModule::AssetCreated(Material);
+	AssetPackage->SetDirtyFlag(true);
+
+	return Material;
+}
+
+UMaterialInstanceConstant* ImportMaterialInstanceFromOpenGEX(OGEX::MaterialStructure* MaterialStruct, int32 Index, UMaterial* ParentMaterial, UObject* InParent, const FString& FileName, FName InName, EObjectFlags Flags, FOpenGEXTextureCache& TextureCache, FOpenGEXAssetNameCache& NameCache, const FString& ContentHash)
+{
+	FString AssetName;
+	UPackage* AssetPackage = RetrieveAssetPackageAndName<UMaterialInstanceConstant>(NameCache, InParent, UTF8_TO_TCHAR(MaterialStruct->GetMaterialName()), TEXT("MI"), InName, Index, AssetName);
+
+	UMaterialInstanceConstant* UnchangedMaterialInstance = FindUnchangedOpenGEXAsset<UMaterialInstanceConstant>(AssetPackage, AssetName, ContentHash);
+	if (UnchangedMaterialInstance && UnchangedMaterialInstance->Parent == ParentMaterial)
+	{
+		return UnchangedMaterialInstance;
+	}
+
+	TMap<FName, UTexture2D*> Textures = ImportTexturesFromOpenGEX(MaterialStruct, InParent, FileName, InName, Flags, TextureCache, NameCache);
+
+	UMaterialInstanceConstant* MaterialInstance = NewObject<UMaterialInstanceConstant>(AssetPackage, FName(*AssetName), Flags);
+	MaterialInstance->AssetImportData = UOpenGEXAssetImportData::Create(MaterialInstance, FileName, ContentHash);
+	MaterialInstance->SetParentEditorOnly(ParentMaterial);
+
+	Array<OGEX::AttribStructure*>& AttribStructures = MaterialStruct->GetAttribStructures();
+	for (int32 i = 0; i < AttribStructures.GetElementCount(); ++i)
+	{
+		const String& AttribString = AttribStructures[i]->GetAttribString();
+
+		if (AttribStructures[i]->GetStructureType() == OGEX::kStructureColor)
+		{
+			FLinearColor Color = ConvertOpenGEXColorToLinearColor(static_cast<OGEX::ColorStructure*>(AttribStructures[i])->GetColor());
+
+			if (AttribString == "diffuse")
+			{
+				MaterialInstance->SetVectorParameterValueEditorOnly(FMaterialParameterInfo(DiffuseColorParameterName), Color);
+			}
+			else if (AttribString == "specular")
+			{
+				MaterialInstance->SetScalarParameterValueEditorOnly(FMaterialParameterInfo(SpecularParameterName), FMath::Clamp(Color.GetLuminance(), 0.0f, 1.0f));
+			}
+			else if (AttribString == "emission")
+			{
+				MaterialInstance->SetVectorParameterValueEditorOnly(FMaterialParameterInfo(EmissiveColorParameterName), Color);
+			}
+		}
+		else if (AttribStructures[i]->GetStructureType() == OGEX::kStructureParam)
+		{
+			if (AttribString == "specular_power")
+			{
+				// Usual Blinn-Phong exponent to GGX roughness mapping.
+				float SpecularPower = FMath::Max(static_cast<OGEX::ParamStructure*>(AttribStructures[i])->GetParam(), 0.0f);
+				MaterialInstance->SetScalarParameterValueEditorOnly(FMaterialParameterInfo(RoughnessParameterName), FMath::Sqrt(2.0f / (SpecularPower + 2.0f)));
+			}
+		}
+		else if (AttribStructures[i]->GetStructureType() == OGEX::kStructureTexture)
+		{
+			if (AttribString == "diffuse")
+			{
+				UTexture2D** TexturePtr = Textures.Find("diffuse");
+				if (TexturePtr)
+				{
+					MaterialInstance->SetTextureParameterValueEditorOnly(FMaterialParameterInfo(DiffuseTextureParameterName), *TexturePtr);
+				}
+			}
+			else if (AttribString == "normal")
+			{
+				UTexture2D** TexturePtr = Textures.Find("normal");
+				if (TexturePtr)
+				{
+					MaterialInstance->SetTextureParameterValueEditorOnly(FMaterialParameterInfo(NormalTextureParameterName), *TexturePtr);
+				}
+			}
+		}
+	}
+
+	MaterialInstance->PostEditChange();
+
+	FAssetRegistryModule::AssetCreated(MaterialInstance);
+	AssetPackage->SetDirtyFlag(true);
+
+	return MaterialInstance;
+}
+
+static FString FloatBitsToHexForOpenGEX(float Value)
+{
+	uint32 Bits;
+	FMemory::Memcpy(&Bits, &Value, sizeof(Bits));
+	return FString::Printf(TEXT("%08x"), Bits);
+}
+
+// Builds a canonical description of everything the importers read from a material, independent of its name and
+// of the order its attributes appear in. Materials with equal signatures produce identical assets.
+static FString ComputeMaterialSignatureForOpenGEX(OGEX::MaterialStructure* MaterialStruct, const FString& FileName)
+{
+	TArray<FString> Entries;
+
+	Array<OGEX::AttribStructure*>& AttribStructures = MaterialStruct->GetAttribStructures();
+	for (int32 i = 0; i < AttribStructures.GetElementCount(); ++i)
+	{
+		OGEX::AttribStructure* AttribStruct = AttribStructures[i];
+		FString AttribString = FString(UTF8_TO_TCHAR(static_cast<const char*>(AttribStruct->GetAttribString()))).ToLower();
+
+		if (AttribStruct->GetStructureType() == OGEX::kStructureColor)
+		{
+			const float* Color = static_cast<OGEX::ColorStructure*>(AttribStruct)->GetColor();
+			Entries.Add(FString::Printf(TEXT("color:%s=%s,%s,%s,%s"), *AttribString,
+				*FloatBitsToHexForOpenGEX(Color[0]), *FloatBitsToHexForOpenGEX(Color[1]), *FloatBitsToHexForOpenGEX(Color[2]), *FloatBitsToHexForOpenGEX(Color[3])));
+		}
+		else if (AttribStruct->GetStructureType() == OGEX::kStructureParam)
+		{
+			Entries.Add(FString::Printf(TEXT("param:%s=%s"), *AttribString, *FloatBitsToHexForOpenGEX(static_cast<OGEX::ParamStructure*>(AttribStruct)->GetParam())));
+		}
+		else if (AttribStruct->GetStructureType() == OGEX::kStructureTexture)
+		{
+			OGEX::TextureStructure* TextureStruct = static_cast<OGEX::TextureStructure*>(AttribStruct);
+			Entries.Add(FString::Printf(TEXT("texture:%s=%s#%u"), *AttribString, *ResolveTextureFilenameForOpenGEX(TextureStruct, FileName), TextureStruct->GetTexcoordIndex()));
+		}
+	}
+
+	Entries.Add(FString::Printf(TEXT("two_sided=%d"), MaterialStruct->GetTwoSidedFlag() ? 1 : 0));
+	Entries.Sort();
+
+	return FString::Join(Entries, TEXT(";"));
+}
+
+// The signature covers everything the material is built from except the texture contents. Artists edit textures in
+// place under the same path, so the contents of every referenced file go into the reimport hash as well.
+static FString ComputeMaterialContentHashForOpenGEX(OGEX::MaterialStructure* MaterialStruct, const FString& Signature, const FString& FileName, FOpenGEXTextureCache& TextureCache)
+{
+	FSHA1 HashState;
+	HashState.Update(reinterpret_cast<const uint8*>(*Signature), Signature.Len() * sizeof(TCHAR));
+
+	Array<OGEX::AttribStructure*>& AttribStructures = MaterialStruct->GetAttribStructures();
+	for (int32 i = 0; i < AttribStructures.GetElementCount(); ++i)
+	{
+		if (AttribStructures[i]->GetStructureType() == OGEX::kStructureTexture)
+		{
+			const FString TextureFilename = ResolveTextureFilenameForOpenGEX(static_cast<OGEX::TextureStructure*>(AttribStructures[i]), FileName);
+			const FOpenGEXTextureSource& Source = FindOrLoadTextureSourceForOpenGEX(TextureFilename, TextureCache);
+			HashState.Update(Source.Hash.Hash, sizeof(Source.Hash.Hash));
+		}
+	}
+
+	HashState.Final();
+
+	FSHAHash Hash;
+	HashState.GetHash(Hash.Hash);
+	return Hash.ToString();
+}
+
+FOpenGEXMaterialImporter::FOpenGEXMaterialImporter(OGEX::OpenGexDataDescription* OpenGexDataDescriptionPtr, UObject* InParent, const FString& InFileName, FName InName, EObjectFlags InFlags, FOpenGEXAssetNameCache& InNameCache)
+	: Parent(InParent)
+	, FileName(InFileName)
+	, Name(InName)
+	, Flags(InFlags)
+	, NameCache(InNameCache)
+{
+	bUseMaterialInstances = (GetDefault<UOpenGEXImportSettings>()->MaterialImportMode == EOpenGEXMaterialImportMode::MaterialInstances);
+
+	// Fallback asset names use the position of the material in the file, whichever order they get imported in.
 	Structure* StructureNode = OpenGexDataDescriptionPtr->GetRootStructure()->GetFirstSubnode();
 	for (; StructureNode; StructureNode = StructureNode->Next())
 	{
 		if (StructureNode->GetStructureType() == OGEX::kStructureMaterial)
 		{
-			OGEX::MaterialStructure* MaterialStruct = static_cast<OGEX::MaterialStructure*>(StructureNode);
-			UMaterial* Material = ImportMaterialFromOpenGEX(MaterialStruct, Index, InParent, FileName, InName, Flags);
+			MaterialIndices.Add(static_cast<OGEX::MaterialStructure*>(StructureNode), MaterialIndices.Num());
+		}
+	}
+}
 
-			Index += 1;
+void FOpenGEXMaterialImporter::PreloadTextures(const TArray<OGEX::MaterialStructure*>& MaterialStructs)
+{
+	PreloadTexturesFromOpenGEX(MaterialStructs, FileName, TextureCache);
+}
 
-			if (Material)
-			{
-				Materials.Add(MaterialStruct->GetStructureName(), Material);
-			}
+UMaterialInterface* FOpenGEXMaterialImporter::GetOrImportMaterial(OGEX::MaterialStructure* MaterialStruct)
+{
+	OPENGEX_IMPORT_SCOPE(CreateMaterial);
+
+	if (UMaterialInterface** ImportedMaterial = Materials.Find(MaterialStruct))
+	{
+		return *ImportedMaterial;
+	}
+
+	// Exporters often write identical materials under different names, those all share the first one's asset.
+	FString Signature = ComputeMaterialSignatureForOpenGEX(MaterialStruct, FileName);
+	if (UMaterialInterface** SharedMaterial = MaterialsBySignature.Find(Signature))
+	{
+		Materials.Add(MaterialStruct, *SharedMaterial);
+		return *SharedMaterial;
+	}
+
+	const FString ContentHash = ComputeMaterialContentHashForOpenGEX(MaterialStruct, Signature, FileName, TextureCache);
+
+	const int32* MaterialIndex = MaterialIndices.Find(MaterialStruct);
+	const int32 Index = MaterialIndex ? *MaterialIndex : MaterialIndices.Num();
+
+	UMaterialInterface* Material = nullptr;
+	if (bUseMaterialInstances)
+	{
+		if (!ParentMaterial)
+		{
+			ParentMaterial = GetOrCreateParentMaterialForOpenGEX(Parent, Flags, NameCache);
 		}
+
+		Material = ImportMaterialInstanceFromOpenGEX(MaterialStruct, Index, ParentMaterial, Parent, FileName, Name, Flags, TextureCache, NameCache, ContentHash);
+	}
+	else
+	{
+		Material = ImportMaterialFromOpenGEX(MaterialStruct, Index, Parent, FileName, Name, Flags, TextureCache, NameCache, ContentHash);
+	}
+
+	Materials.Add(MaterialStruct, Material);
+	if (Material)
+	{
+		MaterialsBySignature.Add(MoveTemp(Signature), Material);
 	}
 
-	return Materials;
+	return Material;
 }
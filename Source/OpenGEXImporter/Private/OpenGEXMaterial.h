@@ -5,8 +5,81 @@
 
 #include "OpenGEX.h"
 
+#include "Misc/SecureHash.h"
+
 class UTexture2D;
 class UMaterial;
+class UMaterialInterface;
+class FOpenGEXAssetNameCache;
+
+/** A texture file read and, where possible, decoded ahead of asset creation. Filled in on worker threads. */
+struct FOpenGEXTextureSource
+{
+	bool bLoaded = false;
+	FSHAHash Hash;
+
+	/** Raw file contents, kept only for formats that are left to UTextureFactory. */
+	TArray<uint8> FileData;
+
+	/** Decoded BGRA8 pixels. */
+	TArray<uint8> RawData;
+	int32 Width = 0;
+	int32 Height = 0;
+};
+
+/** What a material samples a texture for, which decides its color space and compression. */
+enum class EOpenGEXTextureUsage : uint8
+{
+	Color,
+	Normal,
+	Count
+};
+
+/** Textures created during one import, so an image shared by several materials is only loaded and created once per usage. */
+struct FOpenGEXTextureCache
+{
+	/**
+	 * Sources keyed on resolved path, preloaded in parallel or read on first use. They are kept for the whole import,
+	 * so an image used both as a color and as a normal map is read only once.
+	 */
+	TMap<FString, FOpenGEXTextureSource> Sources;
+
+	/** Keyed on the resolved absolute file path, one map per usage. Failed loads are cached as nullptr. */
+	TMap<FString, UTexture2D*> TexturesByPath[(int32)EOpenGEXTextureUsage::Count];
+
+	/** Keyed on the file contents, one map per usage, catching copies of the same image under different paths. */
+	TMap<FSHAHash, UTexture2D*> TexturesByHash[(int32)EOpenGEXTextureUsage::Count];
+};
+
+TMap<FName, UTexture2D*> ImportTexturesFromOpenGEX(OGEX::MaterialStructure* MaterialStruct, UObject* InParent, const FString& FileName, FName InName, EObjectFlags Flags, FOpenGEXTextureCache& TextureCache, FOpenGEXAssetNameCache& NameCache);
+
+/**
+ * Imports the materials of one OpenGEX file on demand, so only materials some imported mesh actually uses get created.
+ * Must be used from the game thread.
+ */
+class FOpenGEXMaterialImporter
+{
+public:
+	FOpenGEXMaterialImporter(OGEX::OpenGexDataDescription* OpenGexDataDescriptionPtr, UObject* InParent, const FString& InFileName, FName InName, EObjectFlags InFlags, FOpenGEXAssetNameCache& InNameCache);
+
+	/** Reads and decodes the textures of the given materials in parallel ahead of their first use. */
+	void PreloadTextures(const TArray<OGEX::MaterialStructure*>& MaterialStructs);
+
+	/** Returns the asset for the material, importing it (or sharing an identical one) on first use. */
+	UMaterialInterface* GetOrImportMaterial(OGEX::MaterialStructure* MaterialStruct);
+
+private:
+	UObject* Parent;
+	FString FileName;
+	FName Name;
+	EObjectFlags Flags;
+
+	bool bUseMaterialInstances;
+	UMaterial* ParentMaterial = nullptr;
 
-TMap<FName, UTexture2D*> ImportTexturesFromOpenGEX(OGEX::MaterialStructure* MaterialStruct, UObject* InParent, const FString& FileName, FName InName, EObjectFlags Flags);
-TMap<FName, UMaterial*> ImportMaterialsFromOpenGEX(OGEX::OpenGexDataDescription* OpenGexDataDescriptionPtr, UObject* InParent, const FString& FileName, FName InName, EObjectFlags Flags);
\ No newline at end of file
+	TMap<OGEX::MaterialStructure*, int32> MaterialIndices;
+	TMap<OGEX::MaterialStructure*, UMaterialInterface*> Materials;
+	TMap<FString, UMaterialInterface*> MaterialsBySignature;
+	FOpenGEXTextureCache TextureCache;
+	FOpenGEXAssetNameCache& NameCache;
+};
@@ -0,0 +1,77 @@
+#include "OpenGEXReimportFactory.h"
+
+#include "Misc/FeedbackContext.h"
+#include "Misc/Paths.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/SkeletalMesh.h"
+#include "OpenGEXAssetImportData.h"
+#include "OpenGEXCommons.h"
+
+static UOpenGEXAssetImportData* GetOpenGEXImportData(UObject* Obj)
+{
+	if (UStaticMesh* StaticMesh = Cast<UStaticMesh>(Obj))
+	{
+		return Cast<UOpenGEXAssetImportData>(StaticMesh->AssetImportData);
+	}
+
+	if (USkeletalMesh* SkeletalMesh = Cast<USkeletalMesh>(Obj))
+	{
+		return Cast<UOpenGEXAssetImportData>(SkeletalMesh->AssetImportData);
+	}
+
+	return nullptr;
+}
+
+UOpenGEXReimportFactory::UOpenGEXReimportFactory(const FObjectInitializer& ObjectInitializer /*= FObjectInitializer::Get()*/)
+	: Super(ObjectInitializer)
+{
+	// Only used through the reimport handler, never offered for fresh imports.
+	ImportPriority = DefaultImportPriority - 1;
+}
+
+bool UOpenGEXReimportFactory::CanReimport(UObject* Obj, TArray<FString>& OutFilenames)
+{
+	UOpenGEXAssetImportData* ImportData = GetOpenGEXImportData(Obj);
+	if (ImportData)
+	{
+		ImportData->ExtractFilenames(OutFilenames);
+		return true;
+	}
+
+	return false;
+}
+
+void UOpenGEXReimportFactory::SetReimportPaths(UObject* Obj, const TArray<FString>& NewReimportPaths)
+{
+	UOpenGEXAssetImportData* ImportData = GetOpenGEXImportData(Obj);
+	if (ImportData && ensure(NewReimportPaths.Num() == 1))
+	{
+		ImportData->UpdateFilenameOnly(NewReimportPaths[0]);
+	}
+}
+
+EReimportResult::Type UOpenGEXReimportFactory::Reimport(UObject* Obj)
+{
+	UOpenGEXAssetImportData* ImportData = GetOpenGEXImportData(Obj);
+	if (!ImportData)
+	{
+		return EReimportResult::Failed;
+	}
+
+	const FString FileName = ImportData->GetFirstFilename();
+	if (FileName.IsEmpty() || !FPaths::FileExists(FileName))
+	{
+		UE_LOG(LogOpenGEXImporter, Error, TEXT("Cannot reimport '%s', source file '%s' is missing"), *Obj->GetPathName(), *FileName);
+		return EReimportResult::Failed;
+	}
+
+	// Runs the regular import into the asset's folder. Assets are found again by name and only rebuilt when their hash changed.
+	UObject* Mesh = ImportMeshesAndMaterialsFromOpenGEXFile(FileName, Obj->GetOutermost(), FName(*FPaths::GetBaseFilename(FileName)), RF_Public | RF_Standalone | RF_Transactional, GWarn);
+
+	return Mesh ? EReimportResult::Succeeded : EReimportResult::Failed;
+}
+
+int32 UOpenGEXReimportFactory::GetPriority() const
+{
+	return ImportPriority;
+}
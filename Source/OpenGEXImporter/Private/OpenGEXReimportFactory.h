@@ -0,0 +1,24 @@
+#pragma once
+
+#include "EditorReimportHandler.h"
+#include "OpenGEXImporterFactory.h"
+
+#include "OpenGEXReimportFactory.generated.h"
+
+/**
+ * Reimports static meshes created from OpenGEX files. The whole file is parsed again, but meshes and materials whose
+ * content hash did not change since the last import are left untouched.
+ */
+UCLASS()
+class UOpenGEXReimportFactory : public UOpenGEXImporterFactory, public FReimportHandler
+{
+	GENERATED_BODY()
+
+public:
+	UOpenGEXReimportFactory(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
+
+	bool CanReimport(UObject* Obj, TArray<FString>& OutFilenames) override;
+	void SetReimportPaths(UObject* Obj, const TArray<FString>& NewReimportPaths) override;
+	EReimportResult::Type Reimport(UObject* Obj) override;
+	int32 GetPriority() const override;
+};
@@ -0,0 +1,96 @@
+#include "OpenGEXScene.h"
+
+#include "Engine/Blueprint.h"
+#include "Engine/BlueprintGeneratedClass.h"
+#include "Engine/SimpleConstructionScript.h"
+#include "Engine/SCS_Node.h"
+#include "Engine/StaticMesh.h"
+#include "Components/StaticMeshComponent.h"
+#include "Components/HierarchicalInstancedStaticMeshComponent.h"
+#include "GameFramework/Actor.h"
+#include "Kismet2/KismetEditorUtilities.h"
+#include "AssetRegistryModule.h"
+#include "OpenGEXUtility.h"
+#include "OpenGEXCommons.h"
+
+// Object-only matrices apply to the node's own geometry, after the transforms of the node and everything above it.
+static FTransform GetOpenGEXNodeTransform(const OGEX::NodeStructure* Node, const FOpenGEXSpaceConversion& Conversion)
+{
+	return FTransform(Conversion.ConvertTransform(Node->GetObjectTransform()) * Conversion.ConvertTransform(Node->GetGlobalTransform()));
+}
+
+UBlueprint* ImportSceneBlueprintFromOpenGEX(OGEX::OpenGexDataDescription* OpenGexDataDescriptionPtr, const TMap<OGEX::GeometryNodeStructure*, UStaticMesh*>& NodeMeshes, const TArray<UStaticMesh*>& WorldMeshes, const FString& FileName, UObject* InParent, FName InName, EObjectFlags Flags, FOpenGEXAssetNameCache& NameCache)
+{
+	if (NodeMeshes.Num() == 0 && WorldMeshes.Num() == 0)
+		return nullptr;
+
+	const FOpenGEXSpaceConversion Conversion(OpenGexDataDescriptionPtr);
+
+	// Meshes keep the order of their first node, so components come out in file order.
+	TMap<UStaticMesh*, TArray<FTransform>> MeshInstances;
+	for (const TPair<OGEX::GeometryNodeStructure*, UStaticMesh*>& NodeMesh : NodeMeshes)
+	{
+		MeshInstances.FindOrAdd(NodeMesh.Value).Add(GetOpenGEXNodeTransform(NodeMesh.Key, Conversion));
+	}
+	for (UStaticMesh* WorldMesh : WorldMeshes)
+	{
+		MeshInstances.FindOrAdd(WorldMesh).Add(FTransform::Identity);
+	}
+
+	FString BlueprintName;
+	UPackage* BlueprintPackage = RetrieveAssetPackageAndName<UBlueprint>(NameCache, InParent, InName.ToString() + TEXT("_Scene"), TEXT("BP"), InName, 0, BlueprintName);
+
+	UBlueprint* Blueprint = FindObject<UBlueprint>(BlueprintPackage, *BlueprintName);
+	const bool bCreated = (Blueprint == nullptr);
+	if (bCreated)
+	{
+		Blueprint = FKismetEditorUtilities::CreateBlueprint(AActor::StaticClass(), BlueprintPackage, FName(*BlueprintName), BPTYPE_Normal, UBlueprint::StaticClass(), UBlueprintGeneratedClass::StaticClass());
+	}
+
+	USimpleConstructionScript* SCS = Blueprint->SimpleConstructionScript;
+	for (USCS_Node* ExistingNode : SCS->GetAllNodes())
+	{
+		SCS->RemoveNode(ExistingNode);
+	}
+
+	USCS_Node* RootNode = SCS->CreateNode(USceneComponent::StaticClass(), TEXT("SceneRoot"));
+	SCS->AddNode(RootNode);
+
+	for (const TPair<UStaticMesh*, TArray<FTransform>>& Instances : MeshInstances)
+	{
+		UStaticMesh* StaticMesh = Instances.Key;
+		if (Instances.Value.Num() == 1)
+		{
+			USCS_Node* MeshNode = SCS->CreateNode(UStaticMeshComponent::StaticClass(), FName(*StaticMesh->GetName()));
+			UStaticMeshComponent* Component = CastChecked<UStaticMeshComponent>(MeshNode->ComponentTemplate);
+			Component->SetStaticMesh(StaticMesh);
+			Component->SetRelativeTransform(Instances.Value[0]);
+			RootNode->AddChildNode(MeshNode);
+		}
+		else
+		{
+			// One component draws every copy of the mesh, culled and batched per cluster of instances.
+			USCS_Node* MeshNode = SCS->CreateNode(UHierarchicalInstancedStaticMeshComponent::StaticClass(), FName(*(StaticMesh->GetName() + TEXT("_Instances"))));
+			UHierarchicalInstancedStaticMeshComponent* Component = CastChecked<UHierarchicalInstancedStaticMeshComponent>(MeshNode->ComponentTemplate);
+			Component->SetStaticMesh(StaticMesh);
+			Component->PerInstanceSMData.Reserve(Instances.Value.Num());
+			for (const FTransform& InstanceTransform : Instances.Value)
+			{
+				Component->PerInstanceSMData.Add(FInstancedStaticMeshInstanceData(InstanceTransform.ToMatrixWithScale()));
+			}
+			RootNode->AddChildNode(MeshNode);
+		}
+	}
+
+	UE_LOG(LogOpenGEXImporter, Log, TEXT("Scene '%s': %d nodes and %d merged meshes placed with %d components"), *BlueprintName, NodeMeshes.Num(), WorldMeshes.Num(), MeshInstances.Num());
+
+	FKismetEditorUtilities::CompileBlueprint(Blueprint);
+
+	if (bCreated)
+	{
+		FAssetRegistryModule::AssetCreated(Blueprint);
+	}
+	BlueprintPackage->SetDirtyFlag(true);
+
+	return Blueprint;
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectMacros.h"
+#include "OpenGEX.h"
+
+class UBlueprint;
+class UStaticMesh;
+class FOpenGEXAssetNameCache;
+
+/**
+ * Creates, or rebuilds on reimport, a Blueprint actor that places the static mesh of every geometry node at the node's transform.
+ * All nodes that share a mesh become instances of one hierarchical instanced static mesh component.
+ * WorldMeshes already have their placement baked into the vertices and are added untransformed.
+ */
+UBlueprint* ImportSceneBlueprintFromOpenGEX(OGEX::OpenGexDataDescription* OpenGexDataDescriptionPtr, const TMap<OGEX::GeometryNodeStructure*, UStaticMesh*>& NodeMeshes, const TArray<UStaticMesh*>& WorldMeshes, const FString& FileName, UObject* InParent, FName InName, EObjectFlags Flags, FOpenGEXAssetNameCache& NameCache);
@@ -0,0 +1,569 @@
+#include "OpenGEXSkeletalMesh.h"
+
+#include "Engine/SkeletalMesh.h"
+#include "Animation/Skeleton.h"
+#include "Animation/MorphTarget.h"
+#include "ReferenceSkeleton.h"
+#include "Rendering/SkeletalMeshModel.h"
+#include "Rendering/SkeletalMeshLODModel.h"
+#include "Rendering/SkeletalMeshLODImporterData.h"
+#include "MeshUtilities.h"
+#include "AssetRegistryModule.h"
+#include "Async/ParallelFor.h"
+#include "Runtime/Launch/Resources/Version.h"
+#include "OpenGEXUtility.h"
+#include "OpenGEXAnimation.h"
+#include "OpenGEXMaterial.h"
+#include "OpenGEXAssetImportData.h"
+#include "OpenGEXImportSettings.h"
+#include "OpenGEXCommons.h"
+
+// The mesh map is keyed by LOD level, so its first mesh is the base LOD.
+static OGEX::MeshStructure* GetBaseOpenGEXMesh(OGEX::GeometryNodeStructure* GeometryNode)
+{
+	if (!GeometryNode->geometryObjectStructure)
+		return nullptr;
+
+	return GeometryNode->geometryObjectStructure->GetMeshMap()->First();
+}
+
+bool IsSkinnedOpenGEXGeometryNode(OGEX::GeometryNodeStructure* GeometryNode)
+{
+	OGEX::MeshStructure* MeshStruct = GetBaseOpenGEXMesh(GeometryNode);
+	return MeshStruct && MeshStruct->GetSkinStructure();
+}
+
+/**
+ * Fixed-width influences of every vertex of a skin, heaviest first and normalized to sum up to one.
+ * Vertices are stored in blocks of four, slot-major within a block, so one slot of a whole block is a single
+ * vector: Weights[(Block * MAX_TOTAL_INFLUENCES + Slot) * 4 + Lane].
+ */
+struct FOpenGEXPackedInfluences
+{
+	int32 NumVertices = 0;
+	TArray<float, TAlignedHeapAllocator<16>> Weights;
+	TArray<uint16> BoneIndices;
+};
+
+// Selects the MAX_TOTAL_INFLUENCES heaviest influences of every vertex and renormalizes them, four vertices at a time.
+static void PackOpenGEXInfluences(const OGEX::SkinStructure* SkinStruct, const TArray<uint16>& SkinBoneToBoneIndex, FOpenGEXPackedInfluences& OutPacked)
+{
+	const int32 NumVertices = SkinStruct->GetBoneCountArrayStructure()->GetVertexCount();
+	const int32 NumSkinBones = SkinBoneToBoneIndex.Num();
+
+	const int32 NumBlocks = (NumVertices + 3) / 4;
+	const int32 BlockSize = MAX_TOTAL_INFLUENCES * 4;
+
+	OutPacked.NumVertices = NumVertices;
+	OutPacked.Weights.SetNumZeroed(NumBlocks * BlockSize);
+	OutPacked.BoneIndices.SetNumZeroed(NumBlocks * BlockSize);
+
+	ParallelFor(NumBlocks, [&](int32 Block)
+	{
+		float* BlockWeights = &OutPacked.Weights[Block * BlockSize];
+		uint16* BlockBoneIndices = &OutPacked.BoneIndices[Block * BlockSize];
+
+		for (int32 Lane = 0; Lane < 4; ++Lane)
+		{
+			const int32 VertexIndex = Block * 4 + Lane;
+			if (VertexIndex >= NumVertices)
+				break;
+
+			// Insertion into the short sorted slot list keeps the heaviest influences without sorting the whole list.
+			int32 NumKept = 0;
+			const OGEX::SkinInfluenceSpan Influences = SkinStruct->GetInfluences(VertexIndex);
+			for (int32 Influence = 0; Influence < Influences.influenceCount; ++Influence)
+			{
+				const float Weight = Influences.boneWeightArray[Influence];
+				const int32 SkinBoneIndex = Influences.boneIndexArray[Influence];
+				if (!(Weight > 0.0f) || SkinBoneIndex >= NumSkinBones)
+					continue;
+
+				int32 Slot = NumKept;
+				while (Slot > 0 && BlockWeights[(Slot - 1) * 4 + Lane] < Weight)
+				{
+					if (Slot < MAX_TOTAL_INFLUENCES)
+					{
+						BlockWeights[Slot * 4 + Lane] = BlockWeights[(Slot - 1) * 4 + Lane];
+						BlockBoneIndices[Slot * 4 + Lane] = BlockBoneIndices[(Slot - 1) * 4 + Lane];
+					}
+					--Slot;
+				}
+
+				if (Slot < MAX_TOTAL_INFLUENCES)
+				{
+					BlockWeights[Slot * 4 + Lane] = Weight;
+					BlockBoneIndices[Slot * 4 + Lane] = SkinBoneToBoneIndex[SkinBoneIndex];
+					NumKept = FMath::Min(NumKept + 1, MAX_TOTAL_INFLUENCES);
+				}
+			}
+
+			// Vertices without any usable influence stick to the root bone.
+			if (NumKept == 0)
+			{
+				BlockWeights[Lane] = 1.0f;
+				BlockBoneIndices[Lane] = 0;
+			}
+		}
+
+		VectorRegister Sum = VectorZero();
+		for (int32 Slot = 0; Slot < MAX_TOTAL_INFLUENCES; ++Slot)
+		{
+			Sum = VectorAdd(Sum, VectorLoadAligned(&BlockWeights[Slot * 4]));
+		}
+
+		// Padding lanes of the last block sum up to zero and must not produce NaNs.
+		const VectorRegister Scale = VectorSelect(VectorCompareGT(Sum, VectorZero()), VectorReciprocalAccurate(Sum), VectorZero());
+		for (int32 Slot = 0; Slot < MAX_TOTAL_INFLUENCES; ++Slot)
+		{
+			VectorStoreAligned(VectorMultiply(VectorLoadAligned(&BlockWeights[Slot * 4]), Scale), &BlockWeights[Slot * 4]);
+		}
+	});
+}
+
+/** Bones of a skin, ordered so that every parent comes before its children. */
+struct FOpenGEXSkeletonDescription
+{
+	TArray<FName> BoneNames;
+	TArray<int32> ParentIndices;
+	TArray<FMatrix> BindMatrices;
+
+	/** The scene node of each bone, nullptr for the added root. */
+	TArray<const OGEX::NodeStructure*> BoneNodes;
+
+	/** Maps the bone indices used by the skin to indices into the arrays above. */
+	TArray<uint16> SkinBoneToBoneIndex;
+};
+
+static void BuildSkeletonDescriptionFromOpenGEX(const OGEX::SkeletonStructure* SkeletonStruct, const FOpenGEXSpaceConversion& Conversion, FOpenGEXSkeletonDescription& OutSkeleton)
+{
+	const OGEX::BoneRefArrayStructure* BoneRefArrayStruct = SkeletonStruct->GetBoneRefArrayStructure();
+	const OGEX::TransformStructure* TransformStruct = SkeletonStruct->GetTransformStructure();
+	const OGEX::BoneNodeStructure* const* BoneNodes = BoneRefArrayStruct->GetBoneNodeArray();
+	const int32 NumSkinBones = BoneRefArrayStruct->GetBoneCount();
+
+	TMap<const Structure*, int32> SkinBoneIndices;
+	for (int32 SkinBoneIndex = 0; SkinBoneIndex < NumSkinBones; ++SkinBoneIndex)
+	{
+		SkinBoneIndices.Add(BoneNodes[SkinBoneIndex], SkinBoneIndex);
+	}
+
+	// The skeleton only lists the bones the skin uses, so a bone's parent is its nearest referenced ancestor.
+	TArray<int32> SkinParents;
+	TArray<int32> SkinDepths;
+	TArray<int32> SortedSkinBones;
+	int32 NumRoots = 0;
+	for (int32 SkinBoneIndex = 0; SkinBoneIndex < NumSkinBones; ++SkinBoneIndex)
+	{
+		int32 Parent = INDEX_NONE;
+		int32 Depth = 0;
+		for (const Structure* Ancestor = BoneNodes[SkinBoneIndex]->GetSuperNode(); Ancestor; Ancestor = Ancestor->GetSuperNode())
+		{
+			if (const int32* AncestorIndex = SkinBoneIndices.Find(Ancestor))
+			{
+				if (Parent == INDEX_NONE)
+				{
+					Parent = *AncestorIndex;
+				}
+				++Depth;
+			}
+		}
+
+		SkinParents.Add(Parent);
+		SkinDepths.Add(Depth);
+		SortedSkinBones.Add(SkinBoneIndex);
+		NumRoots += (Parent == INDEX_NONE) ? 1 : 0;
+	}
+
+	SortedSkinBones.StableSort([&SkinDepths](int32 A, int32 B) { return SkinDepths[A] < SkinDepths[B]; });
+
+	// A reference skeleton has a single root, so several root bones get a common parent at the origin.
+	const bool bAddRoot = NumRoots > 1;
+	if (bAddRoot)
+	{
+		OutSkeleton.BoneNames.Add(TEXT("Root"));
+		OutSkeleton.ParentIndices.Add(INDEX_NONE);
+		OutSkeleton.BindMatrices.Add(FMatrix::Identity);
+		OutSkeleton.BoneNodes.Add(nullptr);
+	}
+
+	OutSkeleton.SkinBoneToBoneIndex.SetNum(NumSkinBones);
+	for (int32 SortedIndex = 0; SortedIndex < NumSkinBones; ++SortedIndex)
+	{
+		OutSkeleton.SkinBoneToBoneIndex[SortedSkinBones[SortedIndex]] = OutSkeleton.BoneNames.Num() + SortedIndex;
+	}
+
+	for (int32 SkinBoneIndex : SortedSkinBones)
+	{
+		const char* NodeName = BoneNodes[SkinBoneIndex]->GetNodeName();
+		const FString BaseBoneName = NodeName ? FString(UTF8_TO_TCHAR(NodeName)) : FString::Printf(TEXT("Bone_%d"), SkinBoneIndex);
+
+		FString BoneName = BaseBoneName;
+		for (int32 Suffix = 1; OutSkeleton.BoneNames.Contains(FName(*BoneName)); ++Suffix)
+		{
+			BoneName = FString::Printf(TEXT("%s_%d"), *BaseBoneName, Suffix);
+		}
+
+		const int32 Parent = SkinParents[SkinBoneIndex];
+		OutSkeleton.BoneNames.Add(FName(*BoneName));
+		OutSkeleton.ParentIndices.Add((Parent != INDEX_NONE) ? OutSkeleton.SkinBoneToBoneIndex[Parent] : (bAddRoot ? 0 : INDEX_NONE));
+		OutSkeleton.BindMatrices.Add(Conversion.ConvertTransform(TransformStruct->GetTransform(SkinBoneIndex)));
+		OutSkeleton.BoneNodes.Add(BoneNodes[SkinBoneIndex]);
+	}
+}
+
+/** The bind-pose geometry and influences of one skinned mesh, in the form IMeshUtilities::BuildSkeletalMesh takes. */
+struct FOpenGEXSkinnedMeshDescription
+{
+	TArray<FVector> Points;
+	TArray<int32> PointToOriginalMap;
+	TArray<SkeletalMeshImportData::FMeshWedge> Wedges;
+	TArray<SkeletalMeshImportData::FMeshFace> Faces;
+	TArray<SkeletalMeshImportData::FVertInfluence> Influences;
+
+	/** Material indices referenced by the index arrays, sorted, one material slot each. */
+	TArray<int32> MaterialIndices;
+
+	/** Takes the file's vertices into Unreal space and places them in the space of the bones' bind transforms. */
+	FMatrix SkinMatrix = FMatrix::Identity;
+
+	bool bHasNormals = false;
+	int32 NumUVs = 0;
+};
+
+// Converts the base LOD of a skinned mesh. Touches no UObjects, so it may run on any thread.
+static bool BuildSkinnedMeshDescriptionFromOpenGEX(OGEX::MeshStructure* MeshStruct, const FOpenGEXSkeletonDescription& Skeleton, const FOpenGEXSpaceConversion& Conversion, FOpenGEXSkinnedMeshDescription& OutDescription)
+{
+	OPENGEX_IMPORT_SCOPE(ConvertMesh);
+
+	const OGEX::SkinStructure* SkinStruct = MeshStruct->GetSkinStructure();
+
+	OGEX::VertexArrayStructure* PositionVertexArrayStruct = MeshStruct->GetVertexArray(OGEX::kVertexAttribPosition);
+	OGEX::VertexArrayStructure* NormalVertexArrayStruct = MeshStruct->GetVertexArray(OGEX::kVertexAttribNormal);
+
+	const DataStructure<FloatDataType>* PositionData = PositionVertexArrayStruct->GetDataStructure();
+	const int32 NumPoints = PositionData->GetDataElementCount() / FMath::Max<int32>(PositionData->GetArraySize(), 1);
+	if (NumPoints != SkinStruct->GetBoneCountArrayStructure()->GetVertexCount())
+		return false;
+
+	TArray<OGEX::VertexArrayStructure*> TexcoordVertexArrayStructs;
+	for (int32 TexcoordIndex = 0; TexcoordIndex < FMath::Min<int32>(OGEX::kMaxVertexAttribIndex, MAX_TEXCOORDS); ++TexcoordIndex)
+	{
+		if (OGEX::VertexArrayStructure* TexcoordVertexArrayStruct = MeshStruct->GetVertexArray(OGEX::kVertexAttribTexcoord, TexcoordIndex))
+		{
+			TexcoordVertexArrayStructs.Add(TexcoordVertexArrayStruct);
+		}
+	}
+
+	OutDescription.bHasNormals = NormalVertexArrayStruct != nullptr;
+	OutDescription.NumUVs = FMath::Max(TexcoordVertexArrayStructs.Num(), 1);
+
+	// The skin transform places the mesh in the space of the bones' bind transforms. It is fused with the space
+	// conversion, so positions and normals each take a single pass.
+	const OGEX::TransformStructure* SkinTransformStruct = SkinStruct->GetTransformStructure();
+	const FMatrix SkinMatrix = Conversion.Matrix * (SkinTransformStruct ? Conversion.ConvertTransform(SkinTransformStruct->GetTransform()) : FMatrix::Identity);
+	OutDescription.SkinMatrix = SkinMatrix;
+
+	TransformOpenGEXVertexArray(PositionVertexArrayStruct, SkinMatrix, false, OutDescription.Points);
+
+	TArray<FVector> Normals;
+	if (NormalVertexArrayStruct)
+	{
+		TransformOpenGEXVertexArray(NormalVertexArrayStruct, SkinMatrix.Inverse().GetTransposed(), true, Normals);
+	}
+
+	OutDescription.PointToOriginalMap.SetNumUninitialized(NumPoints);
+	for (int32 PointIndex = 0; PointIndex < NumPoints; ++PointIndex)
+	{
+		OutDescription.PointToOriginalMap[PointIndex] = PointIndex;
+	}
+
+	FOpenGEXPackedInfluences PackedInfluences;
+	PackOpenGEXInfluences(SkinStruct, Skeleton.SkinBoneToBoneIndex, PackedInfluences);
+
+	OutDescription.Influences.Reserve(NumPoints * 2);
+	for (int32 PointIndex = 0; PointIndex < NumPoints; ++PointIndex)
+	{
+		const int32 BlockOffset = (PointIndex / 4) * MAX_TOTAL_INFLUENCES * 4 + (PointIndex % 4);
+		for (int32 Slot = 0; Slot < MAX_TOTAL_INFLUENCES; ++Slot)
+		{
+			const float Weight = PackedInfluences.Weights[BlockOffset + Slot * 4];
+			if (Weight <= 0.0f)
+				break;
+
+			SkeletalMeshImportData::FVertInfluence& Influence = OutDescription.Influences.AddDefaulted_GetRef();
+			Influence.Weight = Weight;
+			Influence.VertIndex = PointIndex;
+			Influence.BoneIndex = PackedInfluences.BoneIndices[BlockOffset + Slot * 4];
+		}
+	}
+
+	Array<OGEX::IndexArrayStructure*>& Primitives = MeshStruct->GetIndexArrayStructures();
+
+	TSet<int32> MaterialIndicesUsed;
+	int32 TotalIndexCount = 0;
+	for (int32 PrimIndex = 0; PrimIndex < Primitives.GetElementCount(); ++PrimIndex)
+	{
+		MaterialIndicesUsed.Add(Primitives[PrimIndex]->GetMaterialIndex());
+		TotalIndexCount += Primitives[PrimIndex]->GetIndicesArray().GetElementCount();
+	}
+
+	OutDescription.MaterialIndices = MaterialIndicesUsed.Array();
+	OutDescription.MaterialIndices.Sort();
+
+	OutDescription.Wedges.Reserve(TotalIndexCount);
+	OutDescription.Faces.Reserve(TotalIndexCount / 3);
+
+	// Index arrays are triangle lists by now, so every three indices make one face with its own three wedges.
+	for (int32 PrimIndex = 0; PrimIndex < Primitives.GetElementCount(); ++PrimIndex)
+	{
+		OGEX::IndexArrayStructure* Prim = Primitives[PrimIndex];
+		Array<uint32>& Indices = Prim->GetIndicesArray();
+		const uint16 MaterialSlot = OutDescription.MaterialIndices.IndexOfByKey(Prim->GetMaterialIndex());
+
+		for (int32 TriangleStart = 0; TriangleStart + 2 < Indices.GetElementCount(); TriangleStart += 3)
+		{
+			SkeletalMeshImportData::FMeshFace& Face = OutDescription.Faces.AddZeroed_GetRef();
+			Face.MeshMaterialIndex = MaterialSlot;
+
+			for (int32 Corner = 0; Corner < 3; ++Corner)
+			{
+				const uint32 VertexIndex = Indices[TriangleStart + (Conversion.bFlipWinding ? (3 - Corner) % 3 : Corner)];
+
+				SkeletalMeshImportData::FMeshWedge& Wedge = OutDescription.Wedges.AddZeroed_GetRef();
+				Wedge.iVertex = VertexIndex;
+				Wedge.Color = FColor::White;
+				for (int32 UVIndex = 0; UVIndex < TexcoordVertexArrayStructs.Num(); ++UVIndex)
+				{
+					Wedge.UVs[UVIndex] = ConvertOpenGEXFloat2(TexcoordVertexArrayStructs[UVIndex]->GetDataStructure()->GetArrayDataElement(VertexIndex));
+				}
+
+				Face.iWedge[Corner] = OutDescription.Wedges.Num() - 1;
+				Face.TangentX[Corner] = FVector::ZeroVector;
+				Face.TangentY[Corner] = FVector::ZeroVector;
+				Face.TangentZ[Corner] = NormalVertexArrayStruct ? Normals[VertexIndex] : FVector::ZeroVector;
+			}
+		}
+	}
+
+	OPENGEX_IMPORT_COUNT(Vertices, OutDescription.Wedges.Num());
+	OPENGEX_IMPORT_COUNT(Triangles, OutDescription.Faces.Num());
+
+	return true;
+}
+
+// Adds a morph target for every morph of the geometry. Each one keeps only the vertices whose position or normal
+// differs from the base mesh by more than the import thresholds, so shapes that move a small region stay small.
+static void ImportMorphTargetsFromOpenGEX(OGEX::GeometryNodeStructure* GeometryNode, OGEX::MeshStructure* MeshStruct, const FMatrix& SkinMatrix, USkeletalMesh* SkeletalMesh)
+{
+	OPENGEX_IMPORT_SCOPE(ConvertMesh);
+
+	Map<OGEX::MorphStructure>* MorphMap = GeometryNode->geometryObjectStructure->GetMorphMap();
+	const FSkeletalMeshLODModel& LODModel = SkeletalMesh->GetImportedModel()->LODModels[0];
+
+	const DataStructure<FloatDataType>* BasePositionData = MeshStruct->GetVertexArray(OGEX::kVertexAttribPosition)->GetDataStructure();
+	const OGEX::VertexArrayStructure* BaseNormalVertexArrayStruct = MeshStruct->GetVertexArray(OGEX::kVertexAttribNormal);
+	const DataStructure<FloatDataType>* BaseNormalData = BaseNormalVertexArrayStruct ? BaseNormalVertexArrayStruct->GetDataStructure() : nullptr;
+	const int32 NumPoints = BasePositionData->GetDataElementCount() / FMath::Max<int32>(BasePositionData->GetArraySize(), 1);
+
+	if (LODModel.MeshToImportVertexMap.Num() != LODModel.NumVertices)
+	{
+		UE_LOG(LogOpenGEXImporter, Warning, TEXT("Skipped morph targets of '%s', its vertices can't be traced back to the file"), *SkeletalMesh->GetName());
+		return;
+	}
+
+	const UOpenGEXImportSettings* Settings = GetDefault<UOpenGEXImportSettings>();
+	const VectorRegister PositionThreshold = VectorSetFloat1(Settings->MorphTargetPositionThreshold);
+	const VectorRegister NormalThreshold = VectorSetFloat1(Settings->MorphTargetNormalThreshold);
+	const FMatrix SkinNormalMatrix = SkinMatrix.Inverse().GetTransposed();
+
+	TArray<bool> Moved;
+	for (OGEX::MorphStructure* MorphStruct = MorphMap->First(); MorphStruct; MorphStruct = MorphStruct->Next())
+	{
+		// Morph 0 is the base mesh itself.
+		const uint32 MorphIndex = MorphStruct->GetMorphIndex();
+		if (MorphIndex == 0)
+			continue;
+
+		const OGEX::VertexArrayStructure* PositionVertexArrayStruct = MeshStruct->GetMorphVertexArray(OGEX::kVertexAttribPosition, MorphIndex);
+		const OGEX::VertexArrayStructure* NormalVertexArrayStruct = BaseNormalData ? MeshStruct->GetMorphVertexArray(OGEX::kVertexAttribNormal, MorphIndex) : nullptr;
+		const DataStructure<FloatDataType>* PositionData = PositionVertexArrayStruct ? PositionVertexArrayStruct->GetDataStructure() : BasePositionData;
+		const DataStructure<FloatDataType>* NormalData = NormalVertexArrayStruct ? NormalVertexArrayStruct->GetDataStructure() : BaseNormalData;
+
+		if (PositionData->GetDataElementCount() != BasePositionData->GetDataElementCount() ||
+			(NormalData && NormalData->GetDataElementCount() != BaseNormalData->GetDataElementCount()))
+		{
+			UE_LOG(LogOpenGEXImporter, Warning, TEXT("Skipped morph %u of '%s', its vertex count doesn't match the mesh"), MorphIndex, *SkeletalMesh->GetName());
+			continue;
+		}
+
+		const FString MorphName = MorphStruct->GetMorphName() ? FString(UTF8_TO_TCHAR(MorphStruct->GetMorphName())) : FString::Printf(TEXT("Morph_%u"), MorphIndex);
+
+		// Compares the three components of a vertex at once. Loading three floats leaves the fourth lane at zero.
+		Moved.SetNumUninitialized(NumPoints);
+		ParallelFor(NumPoints, [&](int32 PointIndex)
+		{
+			const VectorRegister PositionDelta = VectorSubtract(VectorLoadFloat3(PositionData->GetArrayDataElement(PointIndex)), VectorLoadFloat3(BasePositionData->GetArrayDataElement(PointIndex)));
+			bool bMoved = VectorAnyGreaterThan(VectorAbs(PositionDelta), PositionThreshold) != 0;
+			if (!bMoved && NormalData != BaseNormalData)
+			{
+				const VectorRegister NormalDelta = VectorSubtract(VectorLoadFloat3(NormalData->GetArrayDataElement(PointIndex)), VectorLoadFloat3(BaseNormalData->GetArrayDataElement(PointIndex)));
+				bMoved = VectorAnyGreaterThan(VectorAbs(NormalDelta), NormalThreshold) != 0;
+			}
+
+			Moved[PointIndex] = bMoved;
+		});
+
+		TArray<FMorphTargetDelta> Deltas;
+		for (uint32 VertexIndex = 0; VertexIndex < LODModel.NumVertices; ++VertexIndex)
+		{
+			const int32 PointIndex = LODModel.MeshToImportVertexMap[VertexIndex];
+			if (!Moved[PointIndex])
+				continue;
+
+			FMorphTargetDelta& Delta = Deltas.AddDefaulted_GetRef();
+			Delta.SourceIdx = VertexIndex;
+			const float* Position = PositionData->GetArrayDataElement(PointIndex);
+			const float* BasePosition = BasePositionData->GetArrayDataElement(PointIndex);
+			Delta.PositionDelta = SkinMatrix.TransformVector(FVector(Position[0] - BasePosition[0], Position[1] - BasePosition[1], Position[2] - BasePosition[2]));
+			if (NormalData != BaseNormalData)
+			{
+				const float* Normal = NormalData->GetArrayDataElement(PointIndex);
+				const float* BaseNormal = BaseNormalData->GetArrayDataElement(PointIndex);
+				Delta.TangentZDelta = SkinNormalMatrix.TransformVector(FVector(Normal[0], Normal[1], Normal[2])).GetSafeNormal() - SkinNormalMatrix.TransformVector(FVector(BaseNormal[0], BaseNormal[1], BaseNormal[2])).GetSafeNormal();
+			}
+			else
+			{
+				Delta.TangentZDelta = FVector::ZeroVector;
+			}
+		}
+
+		if (Deltas.Num() == 0)
+			continue;
+
+		UMorphTarget* MorphTarget = NewObject<UMorphTarget>(SkeletalMesh, FName(*MorphName));
+		MorphTarget->PopulateDeltas(Deltas, 0, LODModel.Sections, true);
+		SkeletalMesh->RegisterMorphTarget(MorphTarget);
+	}
+}
+
+static USkeletalMesh* ImportOneSkeletalMeshFromOpenGEX(OGEX::OpenGexDataDescription* OpenGexDataDescriptionPtr, OGEX::GeometryNodeStructure* GeometryNode, FOpenGEXMaterialImporter& MaterialImporter, FOpenGEXAssetNameCache& NameCache, const FString& FileName, UObject* InParent, FName InName, EObjectFlags Flags, int32 Index)
+{
+	OGEX::MeshStructure* MeshStruct = GetBaseOpenGEXMesh(GeometryNode);
+	const OGEX::SkinStructure* SkinStruct = MeshStruct->GetSkinStructure();
+
+	const FOpenGEXSpaceConversion Conversion(OpenGexDataDescriptionPtr);
+
+	FOpenGEXSkeletonDescription SkeletonDescription;
+	BuildSkeletonDescriptionFromOpenGEX(SkinStruct->GetSkeletonStructure(), Conversion, SkeletonDescription);
+
+	FOpenGEXSkinnedMeshDescription MeshDescription;
+	if (!BuildSkinnedMeshDescriptionFromOpenGEX(MeshStruct, SkeletonDescription, Conversion, MeshDescription))
+	{
+		UE_LOG(LogOpenGEXImporter, Error, TEXT("Skin of node '%s' doesn't match its vertex count"), UTF8_TO_TCHAR(GeometryNode->GetNodeName()));
+		return nullptr;
+	}
+
+	FString AssetName;
+	UPackage* AssetPackage = RetrieveAssetPackageAndName<USkeletalMesh>(NameCache, InParent, UTF8_TO_TCHAR(GeometryNode->GetNodeName()), TEXT("SK"), InName, Index, AssetName);
+
+	// Skeletal meshes carry no content hash yet and are rebuilt on every import.
+	USkeletalMesh* SkeletalMesh = NewObject<USkeletalMesh>(AssetPackage, FName(*AssetName), Flags);
+	SkeletalMesh->AssetImportData = UOpenGEXAssetImportData::Create(SkeletalMesh, FileName, FString());
+
+	{
+		FReferenceSkeletonModifier RefSkeletonModifier(SkeletalMesh->RefSkeleton, nullptr);
+		for (int32 BoneIndex = 0; BoneIndex < SkeletonDescription.BoneNames.Num(); ++BoneIndex)
+		{
+			const int32 ParentIndex = SkeletonDescription.ParentIndices[BoneIndex];
+			const FMatrix ParentBindMatrix = (ParentIndex != INDEX_NONE) ? SkeletonDescription.BindMatrices[ParentIndex] : FMatrix::Identity;
+			const FName BoneName = SkeletonDescription.BoneNames[BoneIndex];
+
+			RefSkeletonModifier.Add(FMeshBoneInfo(BoneName, BoneName.ToString(), ParentIndex), FTransform(SkeletonDescription.BindMatrices[BoneIndex] * ParentBindMatrix.Inverse()));
+		}
+	}
+
+	for (int32 MaterialIndex : MeshDescription.MaterialIndices)
+	{
+		OGEX::MaterialStructure* MaterialStruct = (MaterialIndex < GeometryNode->materialStructureArray.GetElementCount()) ? GeometryNode->materialStructureArray[MaterialIndex] : nullptr;
+		UMaterialInterface* Mat = MaterialStruct ? MaterialImporter.GetOrImportMaterial(MaterialStruct) : nullptr;
+		const FName MatName = MaterialStruct ? FName(MaterialStruct->GetMaterialName()) : NAME_None;
+		SkeletalMesh->Materials.Add(FSkeletalMaterial(Mat, true, false, MatName, MatName));
+	}
+
+	FSkeletalMeshModel* ImportedModel = SkeletalMesh->GetImportedModel();
+	ImportedModel->LODModels.Empty();
+	ImportedModel->LODModels.Add(new FSkeletalMeshLODModel());
+	FSkeletalMeshLODModel& LODModel = ImportedModel->LODModels[0];
+	LODModel.NumTexCoords = MeshDescription.NumUVs;
+
+	SkeletalMesh->ResetLODInfo();
+	SkeletalMesh->AddLODInfo();
+
+	IMeshUtilities::MeshBuildOptions BuildOptions;
+	BuildOptions.bComputeNormals = !MeshDescription.bHasNormals;
+	BuildOptions.bComputeTangents = true;
+	BuildOptions.bUseMikkTSpace = true;
+	BuildOptions.bRemoveDegenerateTriangles = false;
+
+	bool bBuilt;
+	{
+		OPENGEX_IMPORT_SCOPE(BuildMesh);
+
+		IMeshUtilities& MeshUtilities = FModuleManager::Get().LoadModuleChecked<IMeshUtilities>("MeshUtilities");
+#if ENGINE_MAJOR_VERSION > 4 || ENGINE_MINOR_VERSION >= 24
+		bBuilt = MeshUtilities.BuildSkeletalMesh(LODModel, SkeletalMesh->GetPathName(), SkeletalMesh->RefSkeleton, MeshDescription.Influences, MeshDescription.Wedges, MeshDescription.Faces, MeshDescription.Points, MeshDescription.PointToOriginalMap, BuildOptions);
+#else
+		bBuilt = MeshUtilities.BuildSkeletalMesh(LODModel, SkeletalMesh->RefSkeleton, MeshDescription.Influences, MeshDescription.Wedges, MeshDescription.Faces, MeshDescription.Points, MeshDescription.PointToOriginalMap, BuildOptions);
+#endif
+	}
+
+	if (!bBuilt)
+	{
+		UE_LOG(LogOpenGEXImporter, Error, TEXT("Failed to build skeletal mesh '%s'"), *AssetName);
+		return nullptr;
+	}
+
+	ImportMorphTargetsFromOpenGEX(GeometryNode, MeshStruct, MeshDescription.SkinMatrix, SkeletalMesh);
+
+	SkeletalMesh->SetImportedBounds(FBoxSphereBounds(MeshDescription.Points.GetData(), MeshDescription.Points.Num()));
+	SkeletalMesh->CalculateInvRefMatrices();
+	SkeletalMesh->PostEditChange();
+
+	FString SkeletonName;
+	UPackage* SkeletonPackage = RetrieveAssetPackageAndName<USkeleton>(NameCache, InParent, AssetName + TEXT("_Skeleton"), TEXT("SKEL"), InName, Index, SkeletonName);
+
+	USkeleton* Skeleton = NewObject<USkeleton>(SkeletonPackage, FName(*SkeletonName), Flags);
+	Skeleton->MergeAllBonesToBoneTree(SkeletalMesh);
+	Skeleton->SetPreviewMesh(SkeletalMesh);
+	SkeletalMesh->Skeleton = Skeleton;
+
+	FAssetRegistryModule::AssetCreated(Skeleton);
+	FAssetRegistryModule::AssetCreated(SkeletalMesh);
+
+	SkeletonPackage->SetDirtyFlag(true);
+	AssetPackage->SetDirtyFlag(true);
+
+	ImportAnimationsFromOpenGEX(OpenGexDataDescriptionPtr, Skeleton, SkeletalMesh->RefSkeleton, SkeletonDescription.BoneNodes, FileName, InParent, AssetName, InName, Flags, NameCache);
+
+	return SkeletalMesh;
+}
+
+TArray<USkeletalMesh*> ImportSkeletalMeshesFromOpenGEX(OGEX::OpenGexDataDescription* OpenGexDataDescriptionPtr, FOpenGEXMaterialImporter& MaterialImporter, FOpenGEXAssetNameCache& NameCache, const FString& FileName, UObject* InParent, FName InName, EObjectFlags Flags, FFeedbackContext* Warn)
+{
+	TArray<USkeletalMesh*> Result;
+
+	int32 Index = 0;
+	for (OGEX::GeometryNodeStructure* GeometryNode : GatherOpenGEXGeometryNodes(OpenGexDataDescriptionPtr))
+	{
+		if (!IsSkinnedOpenGEXGeometryNode(GeometryNode))
+			continue;
+
+		if (USkeletalMesh* SkeletalMesh = ImportOneSkeletalMeshFromOpenGEX(OpenGexDataDescriptionPtr, GeometryNode, MaterialImporter, NameCache, FileName, InParent, InName, Flags, Index++))
+		{
+			Result.Add(SkeletalMesh);
+		}
+	}
+
+	return Result;
+}
@@ -0,0 +1,14 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectMacros.h"
+#include "OpenGEX.h"
+
+class USkeletalMesh;
+class FOpenGEXMaterialImporter;
+class FOpenGEXAssetNameCache;
+
+// Whether the base LOD of the node's geometry is skinned, in which case the node is imported as a skeletal mesh.
+bool IsSkinnedOpenGEXGeometryNode(OGEX::GeometryNodeStructure* GeometryNode);
+
+TArray<USkeletalMesh*> ImportSkeletalMeshesFromOpenGEX(OGEX::OpenGexDataDescription* OpenGexDataDescriptionPtr, FOpenGEXMaterialImporter& MaterialImporter, FOpenGEXAssetNameCache& NameCache, const FString& FileName, UObject* InParent, FName InName, EObjectFlags Flags, FFeedbackContext* Warn);
@@ -7,41 +7,20 @@
 #include "MeshAttributeArray.h"
 #include "Materials/Material.h"
 #include "AssetRegistryModule.h"
+#include "Async/ParallelFor.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "Misc/ScopedSlowTask.h"
 #include "OpenGEXUtility.h"
-
-#include <string>
-
-template <std::size_t Size>
-constexpr std::size_t GetConstCharPtrLength(const char(&)[Size])
-{
-	return Size - 1;
-}
-
-static FVector ConvertOpenGEXFloat3(const float* InFloat3)
-{
-	return { InFloat3[0], -InFloat3[1], InFloat3[2] };
-}
-
-static FVector2D ConvertOpenGEXFloat2(const float* InFloat2)
-{
-	return { InFloat2[0], InFloat2[1] };
-}
+#include "OpenGEXMaterial.h"
+#include "OpenGEXAssetImportData.h"
+#include "OpenGEXCommons.h"
+#include "OpenGEXSkeletalMesh.h"
+#include "OpenGEXImportSettings.h"
+#include "Misc/SecureHash.h"
 
 template <typename T>
 TArray<T> ReIndexForOpenGEX(OGEX::VertexArrayStructure* Source, const Array<uint32>& Indices);
 
-template <>
-TArray<FVector> ReIndexForOpenGEX<FVector>(OGEX::VertexArrayStructure* Source, const Array<uint32>& Indices)
-{
-	TArray<FVector> Result;
-	Result.Reserve(Indices.GetElementCount());
-	for (int32 i = 0; i < Indices.GetElementCount(); ++i)
-	{
-		Result.Add(ConvertOpenGEXFloat3(Source->GetDataStructure()->GetArrayDataElement(Indices[i])));
-	}
-	return Result;
-}
-
 template <>
 TArray<FVector2D> ReIndexForOpenGEX<FVector2D>(OGEX::VertexArrayStructure* Source, const Array<uint32>& Indices)
 {
@@ -54,22 +33,19 @@ TArray<FVector2D> ReIndexForOpenGEX<FVector2D>(OGEX::VertexArrayStructure* Sourc
 	return Result;
 }
 
-static void AssignMaterialsForOpenGEX(OGEX::OpenGexDataDescription* OpenGexDataDescriptionPtr, OGEX::GeometryNodeStructure* GeometryNode, int32 LODIndex, UStaticMesh* StaticMesh, TMap<int32, int32>& OutMaterialIndexToSlot, const TMap<FName, UMaterial*>& Materials, const TSet<int32>& MaterialIndices)
+static void AssignMaterialsForOpenGEX(OGEX::OpenGexDataDescription* OpenGexDataDescriptionPtr, OGEX::GeometryNodeStructure* GeometryNode, int32 LODIndex, UStaticMesh* StaticMesh, TMap<int32, int32>& OutMaterialIndexToSlot, FOpenGEXMaterialImporter& MaterialImporter, const TArray<int32>& SortedMaterialIndices)
 {
-	TArray<int32> SortedMaterialIndices = MaterialIndices.Array();
-	SortedMaterialIndices.Sort();
-
-	const int32 N = MaterialIndices.Num();
+	const int32 N = SortedMaterialIndices.Num();
 	OutMaterialIndexToSlot.Empty(N);
 	StaticMesh->StaticMaterials.Reserve(N);
 
 	for (int32 MaterialIndex : SortedMaterialIndices)
 	{
-		UMaterial* Mat;
+		UMaterialInterface* Mat;
 		int32 MeshSlot;
 
 		OGEX::MaterialStructure* MaterialStruct = GeometryNode->materialStructureArray[MaterialIndex];
-		Mat = Materials[MaterialStruct->GetStructureName()];
+		Mat = MaterialImporter.GetOrImportMaterial(MaterialStruct);
 		FName MatName(MaterialStruct->GetMaterialName());
 		MeshSlot = StaticMesh->StaticMaterials.Emplace(Mat, MatName, MatName);
 
@@ -79,119 +55,376 @@ static void AssignMaterialsForOpenGEX(OGEX::OpenGexDataDescription* OpenGexDataD
 	}
 }
 
-static void DecomposeVertexArraysForOpenGEX(OGEX::OpenGexDataDescription* OpenGexDataDescriptionPtr, OGEX::MeshStructure* MeshStruct,
-	OGEX::VertexArrayStructure* & PositionVertexArrayStruct,
-	OGEX::VertexArrayStructure* & NormalVertexArrayStruct,
-	OGEX::VertexArrayStructure* & TangentVertexArrayStruct,
-	OGEX::VertexArrayStructure* & BitangentVertexArrayStruct,
-	OGEX::VertexArrayStructure* & ColorVertexArrayStruct,
-	TArray<OGEX::VertexArrayStructure*>& TexcoordVertexArrayStructs)
+/** The detached result of converting one OpenGEX MeshStructure (one LOD level). */
+struct FOpenGEXMeshLODDescription
 {
-	Array<OGEX::VertexArrayStructure*>& VerteArrayStructures = MeshStruct->GetVertexArrayStructures();
-	TArray<int32> ReadyForRemoveIndices;
-	for (int32 i = 0; i < VerteArrayStructures.GetElementCount(); ++i)
-	{
-		OGEX::VertexArrayStructure* VertexArrayStruct = VerteArrayStructures[i];
-		std::string AttribStr(VertexArrayStruct->GetArrayAttrib());
-		size_t SubPos = std::string::npos;
+	int32 LODIndex = 0;
+
+	FMeshDescription MeshDescription;
 
-		SubPos = AttribStr.find("position");
-		if (SubPos != std::string::npos)
+	/** Material indices referenced by the index arrays, sorted, one polygon group each. */
+	TArray<int32> MaterialIndices;
+	TArray<FPolygonGroupID> PolygonGroupIDs;
+
+	bool bHasNormals = false;
+	bool bHasTangents = false;
+	int32 NumUVs = 0;
+	bool bDidGenerateTexCoords = false;
+};
+
+// Adds one triangle polygon, creating the edges between its corners that don't exist yet.
+static void AddTriangleForOpenGEX(FMeshDescription* MeshDescription, TEdgeAttributesRef<bool> EdgeHardnesses, TEdgeAttributesRef<float> EdgeCreaseSharpnesses, FPolygonGroupID PolygonGroupID, const FVertexInstanceID (&CornerVertexInstanceIDs)[3], const FVertexID (&CornerVertexIDs)[3], TArray<FMeshDescription::FContourPoint>& Contours)
+{
+	Contours.SetNum(3);
+	for (int32 Corner = 0; Corner < 3; ++Corner)
+	{
+		FMeshDescription::FContourPoint& ContourPoint = Contours[Corner];
+		// Find the matching edge ID
+		uint32 CornerIndices[2];
+		CornerIndices[0] = (Corner + 0) % 3;
+		CornerIndices[1] = (Corner + 1) % 3;
+
+		FVertexID EdgeVertexIDs[2];
+		EdgeVertexIDs[0] = CornerVertexIDs[CornerIndices[0]];
+		EdgeVertexIDs[1] = CornerVertexIDs[CornerIndices[1]];
+
+		FEdgeID MatchEdgeID = MeshDescription->GetVertexPairEdge(EdgeVertexIDs[0], EdgeVertexIDs[1]);
+		if (MatchEdgeID == FEdgeID::Invalid)
 		{
-			PositionVertexArrayStruct = VertexArrayStruct;
+			MatchEdgeID = MeshDescription->CreateEdge(EdgeVertexIDs[0], EdgeVertexIDs[1]);
+			EdgeHardnesses[MatchEdgeID] = false;
+			EdgeCreaseSharpnesses[MatchEdgeID] = 0.0f;
 		}
+		ContourPoint.EdgeID = MatchEdgeID;
+		ContourPoint.VertexInstanceID = CornerVertexInstanceIDs[CornerIndices[0]];
+	}
+
+	const FPolygonID NewPolygonID = MeshDescription->CreatePolygon(PolygonGroupID, Contours);
+	FMeshPolygon& Polygon = MeshDescription->GetPolygon(NewPolygonID);
+
+	FMeshTriangle Triangle;
+	for (int32 Corner = 0; Corner < 3; ++Corner)
+	{
+		Triangle.SetVertexInstanceID(Corner, CornerVertexInstanceIDs[Corner]);
+	}
+	Polygon.Triangles.Reset(1);
+	Polygon.Triangles.Add(Triangle);
+}
+
+/**
+ * Converts one LOD level into a detached mesh description.
+ * Doesn't touch any UObject, so it is safe to run on a worker thread.
+ */
+static void BuildMeshDescriptionFromOpenGEX(OGEX::OpenGexDataDescription* OpenGexDataDescriptionPtr, OGEX::MeshStructure* MeshStruct, FOpenGEXMeshLODDescription& OutLODDescription)
+{
+	OPENGEX_IMPORT_SCOPE(ConvertMesh);
+
+	OutLODDescription.LODIndex = MeshStruct->GetMeshLevel();
+
+	FMeshDescription* MeshDescription = &OutLODDescription.MeshDescription;
+	UStaticMesh::RegisterMeshAttributes(*MeshDescription);
+
+	TVertexAttributesRef<FVector> VertexPositions = MeshDescription->VertexAttributes().GetAttributesRef<FVector>(MeshAttribute::Vertex::Position);
+	TEdgeAttributesRef<bool> EdgeHardnesses = MeshDescription->EdgeAttributes().GetAttributesRef<bool>(MeshAttribute::Edge::IsHard);
+	TEdgeAttributesRef<float> EdgeCreaseSharpnesses = MeshDescription->EdgeAttributes().GetAttributesRef<float>(MeshAttribute::Edge::CreaseSharpness);
+	TVertexInstanceAttributesRef<FVector> VertexInstanceNormals = MeshDescription->VertexInstanceAttributes().GetAttributesRef<FVector>(MeshAttribute::VertexInstance::Normal);
+	TVertexInstanceAttributesRef<FVector> VertexInstanceTangents = MeshDescription->VertexInstanceAttributes().GetAttributesRef<FVector>(MeshAttribute::VertexInstance::Tangent);
+	TVertexInstanceAttributesRef<float> VertexInstanceBinormalSigns = MeshDescription->VertexInstanceAttributes().GetAttributesRef<float>(MeshAttribute::VertexInstance::BinormalSign);
+	TVertexInstanceAttributesRef<FVector2D> VertexInstanceUVs = MeshDescription->VertexInstanceAttributes().GetAttributesRef<FVector2D>(MeshAttribute::VertexInstance::TextureCoordinate);
+
+	OGEX::VertexArrayStructure* PositionVertexArrayStruct = MeshStruct->GetVertexArray(OGEX::kVertexAttribPosition);
+	OGEX::VertexArrayStructure* NormalVertexArrayStruct = MeshStruct->GetVertexArray(OGEX::kVertexAttribNormal);
+	OGEX::VertexArrayStructure* TangentVertexArrayStruct = MeshStruct->GetVertexArray(OGEX::kVertexAttribTangent);
+
+	// Positions, normals and tangents go into Unreal space once per vertex, before they get spread over the vertex instances.
+	const FOpenGEXSpaceConversion Conversion(OpenGexDataDescriptionPtr);
+
+	TArray<FVector> Positions;
+	TransformOpenGEXVertexArray(PositionVertexArrayStruct, Conversion.Matrix, false, Positions);
+
+	TArray<FVector> Normals;
+	if (NormalVertexArrayStruct)
+	{
+		TransformOpenGEXVertexArray(NormalVertexArrayStruct, Conversion.NormalMatrix, true, Normals);
+	}
 
-		SubPos = AttribStr.find("normal");
-		if (SubPos != std::string::npos)
+	TArray<FVector> Tangents;
+	if (TangentVertexArrayStruct)
+	{
+		TransformOpenGEXVertexArray(TangentVertexArrayStruct, Conversion.Matrix, true, Tangents);
+	}
+
+	TArray<OGEX::VertexArrayStructure*> TexcoordVertexArrayStructs;
+	for (int32 TexcoordIndex = 0; TexcoordIndex < FMath::Min<int32>(OGEX::kMaxVertexAttribIndex, MAX_MESH_TEXTURE_COORDS_MD); ++TexcoordIndex)
+	{
+		if (OGEX::VertexArrayStructure* TexcoordVertexArrayStruct = MeshStruct->GetVertexArray(OGEX::kVertexAttribTexcoord, TexcoordIndex))
 		{
-			NormalVertexArrayStruct = VertexArrayStruct;
+			TexcoordVertexArrayStructs.Add(TexcoordVertexArrayStruct);
 		}
+	}
+
+	int32 NumUVs = TexcoordVertexArrayStructs.Num();
+
+	OutLODDescription.bHasNormals = NormalVertexArrayStruct != nullptr;
+	OutLODDescription.bHasTangents = TangentVertexArrayStruct != nullptr;
+	OutLODDescription.NumUVs = NumUVs;
+
+	if (NumUVs <= 0)
+	{
+		OutLODDescription.bDidGenerateTexCoords = true;
+		NumUVs = 1;
+	}
+
+	VertexInstanceUVs.SetNumIndices(NumUVs);
+
+	Array<OGEX::IndexArrayStructure*>& Primitives = MeshStruct->GetIndexArrayStructures();
+
+	TSet<int32> MaterialIndicesUsed;
+	for (int32 PrimIndex = 0; PrimIndex < Primitives.GetElementCount(); ++PrimIndex)
+	{
+		MaterialIndicesUsed.Add(Primitives[PrimIndex]->GetMaterialIndex());
+	}
+
+	OutLODDescription.MaterialIndices = MaterialIndicesUsed.Array();
+	OutLODDescription.MaterialIndices.Sort();
+
+	TMap<int32, FPolygonGroupID> MaterialIndexToPolygonGroupID;
+	//Add the PolygonGroup
+	for (int32 MaterialIndex : OutLODDescription.MaterialIndices)
+	{
+		const FPolygonGroupID& PolygonGroupID = MeshDescription->CreatePolygonGroup();
+		MaterialIndexToPolygonGroupID.Add(MaterialIndex, PolygonGroupID);
+		OutLODDescription.PolygonGroupIDs.Add(PolygonGroupID);
+	}
+
+	// Add the vertex
+	TMap<int32, FVertexID> PositionIndexToVertexID;
+	for (int32 i = 0; i < Positions.Num(); ++i)
+	{
+		FVertexID VertexID = MeshDescription->CreateVertex();
+		VertexPositions[VertexID] = Positions[i];
+		PositionIndexToVertexID.Add(i, VertexID);
+	}
 
-		SubPos = AttribStr.find("tangent");
-		if (SubPos != std::string::npos)
+	int32 TotalIndexCount = 0;
+	for (int32 PrimIndex = 0; PrimIndex < Primitives.GetElementCount(); ++PrimIndex)
+	{
+		TotalIndexCount += Primitives[PrimIndex]->GetIndicesArray().GetElementCount();
+	}
+	MeshDescription->ReserveNewVertexInstances(TotalIndexCount);
+	MeshDescription->ReserveNewPolygons(TotalIndexCount / 3);
+
+	// Index arrays are always triangle lists by now (strips and quads get expanded at parse time), so every
+	// polygon is a single triangle and its triangulation can be written out directly.
+	TArray<FMeshDescription::FContourPoint> Contours;
+
+	for (int32 PrimIndex = 0; PrimIndex < Primitives.GetElementCount(); ++PrimIndex)
+	{
+		OGEX::IndexArrayStructure* Prim = Primitives[PrimIndex];
+		FPolygonGroupID CurrentPolygonGroupID = MaterialIndexToPolygonGroupID[Prim->GetMaterialIndex()];
+		uint32 TriCount = Prim->GetIndicesArray().GetElementCount() / 3;
+
+		Array<uint32>& Indices = Prim->GetIndicesArray();
+
+		TArray<FVector2D> UVs[MAX_MESH_TEXTURE_COORDS_MD];
+
+		if (OutLODDescription.bDidGenerateTexCoords)
 		{
-			TangentVertexArrayStruct = VertexArrayStruct;
+			UVs[0].AddZeroed(Indices.GetElementCount());
 		}
-
-		SubPos = AttribStr.find("bitangent");
-		if (SubPos != std::string::npos)
+		else
 		{
-			BitangentVertexArrayStruct = VertexArrayStruct;
+			for (int32 UVIndex = 0; UVIndex < NumUVs; ++UVIndex)
+			{
+				UVs[UVIndex] = ReIndexForOpenGEX<FVector2D>(TexcoordVertexArrayStructs[UVIndex], Indices);
+			}
 		}
 
-		SubPos = AttribStr.find("color");
-		if (SubPos != std::string::npos)
+		for (uint32 TriangleIndex = 0; TriangleIndex < TriCount; ++TriangleIndex)
 		{
-			ColorVertexArrayStruct = VertexArrayStruct;
+			FVertexInstanceID CornerVertexInstanceIDs[3];
+			FVertexID CornerVertexIDs[3];
+			for (int32 Corner = 0; Corner < 3; ++Corner)
+			{
+				uint32 IndicesIndex = TriangleIndex * 3 + (Conversion.bFlipWinding ? (3 - Corner) % 3 : Corner);
+				int32 VertexIndex = Indices[IndicesIndex];
+
+				FVertexID VertexID = PositionIndexToVertexID[VertexIndex];
+				const FVertexInstanceID& VertexInstanceID = MeshDescription->CreateVertexInstance(VertexID);
+
+				if (Tangents.Num() > 0)
+				{
+					VertexInstanceTangents[VertexInstanceID] = Tangents[VertexIndex];
+				}
+				if (Normals.Num() > 0)
+				{
+					VertexInstanceNormals[VertexInstanceID] = Normals[VertexIndex];
+				}
+
+				if (Tangents.Num() > 0 && Normals.Num() > 0)
+				{
+					VertexInstanceBinormalSigns[VertexInstanceID] = GetBasisDeterminantSign(VertexInstanceTangents[VertexInstanceID].GetSafeNormal(),
+						(VertexInstanceNormals[VertexInstanceID] ^ VertexInstanceTangents[VertexInstanceID]).GetSafeNormal(),
+						VertexInstanceNormals[VertexInstanceID].GetSafeNormal());
+				}
+
+				for (int32 UVIndex = 0; UVIndex < NumUVs; ++UVIndex)
+				{
+					VertexInstanceUVs.Set(VertexInstanceID, UVIndex, UVs[UVIndex][IndicesIndex]);
+				}
+
+				CornerVertexInstanceIDs[Corner] = VertexInstanceID;
+				CornerVertexIDs[Corner] = VertexID;
+			}
+
+			AddTriangleForOpenGEX(MeshDescription, EdgeHardnesses, EdgeCreaseSharpnesses, CurrentPolygonGroupID, CornerVertexInstanceIDs, CornerVertexIDs, Contours);
 		}
+	}
 
-		SubPos = AttribStr.find("texcoord");
-		if (SubPos != std::string::npos)
+	OPENGEX_IMPORT_COUNT(Vertices, MeshDescription->VertexInstances().Num());
+	OPENGEX_IMPORT_COUNT(Triangles, MeshDescription->Polygons().Num());
+}
+
+// Adds the materials a node's meshes actually use, through the material indices of their index arrays.
+static void CollectReferencedMaterialsForOpenGEX(OGEX::GeometryNodeStructure* GeometryNode, TArray<OGEX::MaterialStructure*>& OutMaterials, TSet<OGEX::MaterialStructure*>& SeenMaterials)
+{
+	Map<OGEX::MeshStructure>& MeshMap = *GeometryNode->geometryObjectStructure->GetMeshMap();
+	for (OGEX::MeshStructure* MeshStruct = MeshMap.First(); MeshStruct; MeshStruct = MeshStruct->Next())
+	{
+		Array<OGEX::IndexArrayStructure*>& Primitives = MeshStruct->GetIndexArrayStructures();
+		for (int32 PrimIndex = 0; PrimIndex < Primitives.GetElementCount(); ++PrimIndex)
 		{
-			TexcoordVertexArrayStructs.Add(VertexArrayStruct);
+			const int32 MaterialIndex = Primitives[PrimIndex]->GetMaterialIndex();
+			if (MaterialIndex < GeometryNode->materialStructureArray.GetElementCount())
+			{
+				OGEX::MaterialStructure* MaterialStruct = GeometryNode->materialStructureArray[MaterialIndex];
+				bool bAlreadySeen = false;
+				SeenMaterials.Add(MaterialStruct, &bAlreadySeen);
+				if (!bAlreadySeen)
+				{
+					OutMaterials.Add(MaterialStruct);
+				}
+			}
 		}
 	}
 }
 
-UStaticMesh* ImportOneMeshFromOpenGEX(OGEX::OpenGexDataDescription* OpenGexDataDescriptionPtr, OGEX::GeometryNodeStructure* GeometryNode, const TMap<FName, UMaterial*>& Materials, const FString& FileName, UObject* InParent, FName InName, EObjectFlags Flags, FFeedbackContext* Warn, int32 Index)
+struct FOpenGEXGeometryDescription
 {
-	UStaticMesh* StaticMesh = nullptr;
-
-	if (!GeometryNode->geometryObjectStructure)
-		return StaticMesh;
+	TArray<FOpenGEXMeshLODDescription> LODDescriptions;
+};
 
-	// We should warn if certain things are "fixed up" during import.
-	bool bDidGenerateTexCoords = false;
-	bool bDidGenerateTangents = false;
-	bool bMeshUsesEmptyMaterial = false;
+// Converts every LOD of a geometry object into detached mesh descriptions. Touches no UObjects, so it may run on any thread.
+static void BuildGeometryDescriptionFromOpenGEX(OGEX::OpenGexDataDescription* OpenGexDataDescriptionPtr, OGEX::GeometryObjectStructure* GeometryObject, FOpenGEXGeometryDescription& GeometryDescription)
+{
+	TArray<OGEX::MeshStructure*> MeshStructs;
+	Map<OGEX::MeshStructure>& MeshMap = *GeometryObject->GetMeshMap();
+	for (OGEX::MeshStructure* MeshStruct = MeshMap.First(); MeshStruct; MeshStruct = MeshStruct->Next())
+	{
+		MeshStructs.Add(MeshStruct);
+	}
 
-	OGEX::GeometryObjectStructure* GeometryObject = GeometryNode->geometryObjectStructure;
+	// LOD levels are independent of each other until they get committed, so build them all at once.
+	TArray<FOpenGEXMeshLODDescription>& LODDescriptions = GeometryDescription.LODDescriptions;
+	LODDescriptions.SetNum(MeshStructs.Num());
+	ParallelFor(MeshStructs.Num(), [&](int32 LODDescriptionIndex)
+	{
+		BuildMeshDescriptionFromOpenGEX(OpenGexDataDescriptionPtr, MeshStructs[LODDescriptionIndex], LODDescriptions[LODDescriptionIndex]);
+	});
+}
 
-	FString AssetName;
-	UPackage* AssetPackage = RetrieveAssetPackageAndName<UStaticMesh>(InParent, UTF8_TO_TCHAR(GeometryNode->GetNodeName()), TEXT("SM"), InName, Index, AssetName);
+// Bump whenever the conversion changes, so a reimport rebuilds meshes whose source data did not change.
+static const uint32 OpenGEXStaticMeshImportVersion = 2;
 
-	StaticMesh = NewObject<UStaticMesh>(AssetPackage, FName(*AssetName), Flags);
-	FStaticMeshSourceModel& SourceModel = StaticMesh->AddSourceModel();
+// Hashes the parsed payload of every mesh of a geometry object. Touches no UObjects, so it may run on any thread.
+static FSHAHash HashGeometryObjectForOpenGEX(OGEX::GeometryObjectStructure* GeometryObject)
+{
+	FSHA1 HashState;
+	HashState.Update(reinterpret_cast<const uint8*>(&OpenGEXStaticMeshImportVersion), sizeof(OpenGEXStaticMeshImportVersion));
 
 	Map<OGEX::MeshStructure>& MeshMap = *GeometryObject->GetMeshMap();
-	OGEX::MeshStructure* MeshStruct = MeshMap.First();
-	while (MeshStruct)
+	for (OGEX::MeshStructure* MeshStruct = MeshMap.First(); MeshStruct; MeshStruct = MeshStruct->Next())
 	{
-		int32 LODIndex = MeshStruct->GetMeshLevel();
-		FMeshDescription* MeshDescription = StaticMesh->CreateOriginalMeshDescription(LODIndex);
-		StaticMesh->RegisterMeshAttributes(*MeshDescription);
+		const uint32 MeshLevel = MeshStruct->GetMeshLevel();
+		HashState.Update(reinterpret_cast<const uint8*>(&MeshLevel), sizeof(MeshLevel));
 
-		TVertexAttributesRef<FVector> VertexPositions = MeshDescription->VertexAttributes().GetAttributesRef<FVector>(MeshAttribute::Vertex::Position);
-		TEdgeAttributesRef<bool> EdgeHardnesses = MeshDescription->EdgeAttributes().GetAttributesRef<bool>(MeshAttribute::Edge::IsHard);
-		TEdgeAttributesRef<float> EdgeCreaseSharpnesses = MeshDescription->EdgeAttributes().GetAttributesRef<float>(MeshAttribute::Edge::CreaseSharpness);
-		TPolygonGroupAttributesRef<FName> PolygonGroupImportedMaterialSlotNames = MeshDescription->PolygonGroupAttributes().GetAttributesRef<FName>(MeshAttribute::PolygonGroup::ImportedMaterialSlotName);
-		TVertexInstanceAttributesRef<FVector> VertexInstanceNormals = MeshDescription->VertexInstanceAttributes().GetAttributesRef<FVector>(MeshAttribute::VertexInstance::Normal);
-		TVertexInstanceAttributesRef<FVector> VertexInstanceTangents = MeshDescription->VertexInstanceAttributes().GetAttributesRef<FVector>(MeshAttribute::VertexInstance::Tangent);
-		TVertexInstanceAttributesRef<float> VertexInstanceBinormalSigns = MeshDescription->VertexInstanceAttributes().GetAttributesRef<float>(MeshAttribute::VertexInstance::BinormalSign);
-		TVertexInstanceAttributesRef<FVector4> VertexInstanceColors = MeshDescription->VertexInstanceAttributes().GetAttributesRef<FVector4>(MeshAttribute::VertexInstance::Color);
-		TVertexInstanceAttributesRef<FVector2D> VertexInstanceUVs = MeshDescription->VertexInstanceAttributes().GetAttributesRef<FVector2D>(MeshAttribute::VertexInstance::TextureCoordinate);
+		Array<OGEX::VertexArrayStructure*>& VertexArrayStructures = MeshStruct->GetVertexArrayStructures();
+		for (int32 i = 0; i < VertexArrayStructures.GetElementCount(); ++i)
+		{
+			OGEX::VertexArrayStructure* VertexArrayStruct = VertexArrayStructures[i];
+			const uint32 VertexArrayHeader[4] = { VertexArrayStruct->GetAttribType(), VertexArrayStruct->GetAttribIndex(), VertexArrayStruct->GetMorphIndex(), (uint32)VertexArrayStruct->GetDataStructure()->GetArraySize() };
+			HashState.Update(reinterpret_cast<const uint8*>(VertexArrayHeader), sizeof(VertexArrayHeader));
 
+			const int32 ElementCount = VertexArrayStruct->GetDataStructure()->GetDataElementCount();
+			if (ElementCount > 0)
+			{
+				HashState.Update(reinterpret_cast<const uint8*>(&VertexArrayStruct->GetDataStructure()->GetDataElement(0)), ElementCount * sizeof(float));
+			}
+		}
 
-		OGEX::VertexArrayStructure* PositionVertexArrayStruct = nullptr;
-		OGEX::VertexArrayStructure* NormalVertexArrayStruct = nullptr;
-		OGEX::VertexArrayStructure* TangentVertexArrayStruct = nullptr;
-		OGEX::VertexArrayStructure* BitangentVertexArrayStruct = nullptr;
-		OGEX::VertexArrayStructure* ColorVertexArrayStruct = nullptr;
-		TArray<OGEX::VertexArrayStructure*> TexcoordVertexArrayStructs;
+		Array<OGEX::IndexArrayStructure*>& Primitives = MeshStruct->GetIndexArrayStructures();
+		for (int32 PrimIndex = 0; PrimIndex < Primitives.GetElementCount(); ++PrimIndex)
+		{
+			Array<uint32>& Indices = Primitives[PrimIndex]->GetIndicesArray();
+			const uint32 IndexArrayHeader[2] = { Primitives[PrimIndex]->GetMaterialIndex(), (uint32)Indices.GetElementCount() };
+			HashState.Update(reinterpret_cast<const uint8*>(IndexArrayHeader), sizeof(IndexArrayHeader));
 
-		DecomposeVertexArraysForOpenGEX(OpenGexDataDescriptionPtr, MeshStruct, PositionVertexArrayStruct, NormalVertexArrayStruct, TangentVertexArrayStruct, BitangentVertexArrayStruct, ColorVertexArrayStruct, TexcoordVertexArrayStructs);
+			if (Indices.GetElementCount() > 0)
+			{
+				HashState.Update(reinterpret_cast<const uint8*>(&Indices[0]), Indices.GetElementCount() * sizeof(uint32));
+			}
+		}
+	}
 
-		int32 NumUVs = 0;
+	HashState.Final();
+
+	FSHAHash Hash;
+	HashState.GetHash(Hash.Hash);
+	return Hash;
+}
+
+// A mesh asset depends on its geometry, the file's Metric and on which materials the node binds to it.
+static FString ComputeStaticMeshContentHashForOpenGEX(OGEX::GeometryNodeStructure* GeometryNode, const FSHAHash& GeometryHash, const FOpenGEXSpaceConversion& Conversion)
+{
+	FSHA1 HashState;
+	HashState.Update(GeometryHash.Hash, sizeof(GeometryHash.Hash));
+	HashState.Update(reinterpret_cast<const uint8*>(Conversion.Matrix.M), sizeof(Conversion.Matrix.M));
+
+	for (int32 MaterialIndex = 0; MaterialIndex < GeometryNode->materialStructureArray.GetElementCount(); ++MaterialIndex)
+	{
+		const OGEX::MaterialStructure* MaterialStruct = GeometryNode->materialStructureArray[MaterialIndex];
+		const char* MaterialStructureName = MaterialStruct ? static_cast<const char*>(MaterialStruct->GetStructureName()) : "";
+		HashState.Update(reinterpret_cast<const uint8*>(MaterialStructureName), FCStringAnsi::Strlen(MaterialStructureName) + 1);
+	}
+
+	HashState.Final();
+
+	FSHAHash Hash;
+	HashState.GetHash(Hash.Hash);
+	return Hash.ToString();
+}
+
+// Game thread half of the import: creates the asset and commits the prebuilt descriptions into it.
+// When bConsumeDescription is false the descriptions are copied, so the same geometry can back further nodes.
+static UStaticMesh* CreateStaticMeshFromOpenGEX(OGEX::OpenGexDataDescription* OpenGexDataDescriptionPtr, OGEX::GeometryNodeStructure* GeometryNode, FOpenGEXGeometryDescription& GeometryDescription, bool bConsumeDescription, FOpenGEXMaterialImporter& MaterialImporter, UPackage* AssetPackage, const FString& AssetName, const FString& FileName, const FString& ContentHash, EObjectFlags Flags)
+{
+	check(IsInGameThread());
+
+	UStaticMesh* StaticMesh = NewObject<UStaticMesh>(AssetPackage, FName(*AssetName), Flags);
+	StaticMesh->AssetImportData = UOpenGEXAssetImportData::Create(StaticMesh, FileName, ContentHash);
+
+	for (FOpenGEXMeshLODDescription& LODDescription : GeometryDescription.LODDescriptions)
+	{
+		const int32 LODIndex = LODDescription.LODIndex;
+		while (StaticMesh->SourceModels.Num() <= LODIndex)
 		{
-			NumUVs = TexcoordVertexArrayStructs.Num();
+			StaticMesh->AddSourceModel();
 		}
 
-		VertexInstanceUVs.SetNumIndices(NumUVs);
-
-		FMeshBuildSettings& Settings = SourceModel.BuildSettings;
+		FMeshBuildSettings& Settings = StaticMesh->SourceModels[LODIndex].BuildSettings;
 
-		Settings.bRecomputeNormals = NormalVertexArrayStruct == nullptr;
-		Settings.bRecomputeTangents = TangentVertexArrayStruct == nullptr;
+		Settings.bRecomputeNormals = !LODDescription.bHasNormals;
+		Settings.bRecomputeTangents = !LODDescription.bHasTangents;
 		Settings.bUseMikkTSpace = true;
 
 		Settings.bRemoveDegenerates = false;
@@ -201,213 +434,590 @@ UStaticMesh* ImportOneMeshFromOpenGEX(OGEX::OpenGexDataDescription* OpenGexDataD
 		Settings.bUseHighPrecisionTangentBasis = false;
 		Settings.bUseFullPrecisionUVs = false;
 
-		Settings.bGenerateLightmapUVs = (NumUVs <= 1);
+		Settings.bGenerateLightmapUVs = (LODDescription.NumUVs <= 1);
 
-		TSet<int32> MaterialIndicesUsed;
+		TMap<int32, int32> MaterialIndexToSlot;
+		AssignMaterialsForOpenGEX(OpenGexDataDescriptionPtr, GeometryNode, LODIndex, StaticMesh, MaterialIndexToSlot, MaterialImporter, LODDescription.MaterialIndices);
 
-		// Add the vertex
-		TMap<int32, FVertexID> PositionIndexToVertexID;
-		PositionIndexToVertexID;
-		for (int32 PrimIndex = 0; PrimIndex < MeshStruct->GetIndexArrayStructures().GetElementCount(); ++PrimIndex)
+		FMeshDescription* MeshDescription = StaticMesh->CreateOriginalMeshDescription(LODIndex);
+		if (bConsumeDescription)
 		{
-			OGEX::IndexArrayStructure* IndexArrayStruct = MeshStruct->GetIndexArrayStructures()[PrimIndex];
-			MaterialIndicesUsed.Add(IndexArrayStruct->GetMaterialIndex());
+			*MeshDescription = MoveTemp(LODDescription.MeshDescription);
+		}
+		else
+		{
+			*MeshDescription = LODDescription.MeshDescription;
 		}
 
-		TMap<int32, int32> MaterialIndexToSlot;
-		AssignMaterialsForOpenGEX(OpenGexDataDescriptionPtr, GeometryNode, LODIndex, StaticMesh, MaterialIndexToSlot, Materials, MaterialIndicesUsed);
-
-		TMap<int32, FPolygonGroupID> MaterialIndexToPolygonGroupID;
-		//Add the PolygonGroup
-		for (int32 MaterialIndex : MaterialIndicesUsed)
+		// Slot names depend on this node's material bindings, so they are written into the asset's own copy.
+		TPolygonGroupAttributesRef<FName> PolygonGroupImportedMaterialSlotNames = MeshDescription->PolygonGroupAttributes().GetAttributesRef<FName>(MeshAttribute::PolygonGroup::ImportedMaterialSlotName);
+		for (int32 i = 0; i < LODDescription.MaterialIndices.Num(); ++i)
 		{
-			const FPolygonGroupID& PolygonGroupID = MeshDescription->CreatePolygonGroup();
-			MaterialIndexToPolygonGroupID.Add(MaterialIndex, PolygonGroupID);
-			PolygonGroupImportedMaterialSlotNames[PolygonGroupID] = StaticMesh->StaticMaterials[MaterialIndexToSlot[MaterialIndex]].ImportedMaterialSlotName;
+			PolygonGroupImportedMaterialSlotNames[LODDescription.PolygonGroupIDs[i]] = StaticMesh->StaticMaterials[MaterialIndexToSlot[LODDescription.MaterialIndices[i]]].ImportedMaterialSlotName;
 		}
 
-		for (int32 i = 0; i < PositionVertexArrayStruct->GetDataStructure()->GetDataElementCount(); ++i)
+		StaticMesh->CommitOriginalMeshDescription(LODIndex);
+	}
+
+	AssetPackage->SetDirtyFlag(true);
+
+	return StaticMesh;
+}
+
+// Builds all meshes of one import after every one of them has been created, and only then announces them to the asset
+// registry. The builds themselves still run one after another: this engine has no thread-safe build entry point.
+static void BuildStaticMeshesForOpenGEX(const TArray<UStaticMesh*>& StaticMeshes)
+{
+	if (StaticMeshes.Num() == 0)
+		return;
+
+	OPENGEX_IMPORT_SCOPE(BuildMesh);
+
+	FScopedSlowTask SlowTask(StaticMeshes.Num(), NSLOCTEXT("OpenGEXImporter", "BuildingStaticMeshes", "Building static meshes"));
+	for (UStaticMesh* StaticMesh : StaticMeshes)
+	{
+		SlowTask.EnterProgressFrame();
+
+		// Builds the mesh and also enforces the lightmap restrictions, updates the texture streaming data and lets
+		// listeners know the mesh changed, which a bare Build skips.
+		StaticMesh->PostEditChange();
+	}
+
+	for (UStaticMesh* StaticMesh : StaticMeshes)
+	{
+		FAssetRegistryModule::AssetCreated(StaticMesh);
+	}
+}
+
+/** One index array of a node that gets merged, with the transform that places it in the merged mesh. */
+struct FOpenGEXMergePiece
+{
+	OGEX::MeshStructure* MeshStruct = nullptr;
+	OGEX::IndexArrayStructure* Prim = nullptr;
+
+	/** Takes OpenGEX positions straight into Unreal world space, the space conversion included. */
+	FMatrix PositionMatrix;
+	FMatrix NormalMatrix;
+
+	/** Mirroring transforms turn triangles inside out, so their corners get swapped back. */
+	bool bFlipWinding = false;
+};
+
+/** Pieces that share a material and a grid cell, up to the corner budget. Becomes one merged static mesh. */
+struct FOpenGEXMergeChunk
+{
+	/** The imported material, so materials that got deduplicated end up in the same chunk. */
+	UMaterialInterface* Material = nullptr;
+
+	/** The first OpenGEX material of the chunk, which names its material slot. */
+	OGEX::MaterialStructure* MaterialStruct = nullptr;
+
+	FIntVector Cell;
+
+	/** Counts the chunks that the budget split off the same material and cell before this one. */
+	int32 SplitIndex = 0;
+
+	TArray<int32> PieceIndices;
+	int32 NumVertexInstances = 0;
+
+	FOpenGEXMeshLODDescription LODDescription;
+};
+
+static int32 GetOpenGEXVertexCount(OGEX::MeshStructure* MeshStruct)
+{
+	const DataStructure<FloatDataType>* PositionData = MeshStruct->GetVertexArray(OGEX::kVertexAttribPosition)->GetDataStructure();
+	return PositionData->GetDataElementCount() / FMath::Max<int32>(PositionData->GetArraySize(), 1);
+}
+
+// Builds the single-material mesh description of a merge chunk in world space. Touches no UObjects, so it may run on any thread.
+static void BuildMergedMeshDescriptionFromOpenGEX(const TArray<FOpenGEXMergePiece>& Pieces, FOpenGEXMergeChunk& Chunk)
+{
+	OPENGEX_IMPORT_SCOPE(ConvertMesh);
+
+	FOpenGEXMeshLODDescription& LODDescription = Chunk.LODDescription;
+	FMeshDescription* MeshDescription = &LODDescription.MeshDescription;
+	UStaticMesh::RegisterMeshAttributes(*MeshDescription);
+
+	TVertexAttributesRef<FVector> VertexPositions = MeshDescription->VertexAttributes().GetAttributesRef<FVector>(MeshAttribute::Vertex::Position);
+	TEdgeAttributesRef<bool> EdgeHardnesses = MeshDescription->EdgeAttributes().GetAttributesRef<bool>(MeshAttribute::Edge::IsHard);
+	TEdgeAttributesRef<float> EdgeCreaseSharpnesses = MeshDescription->EdgeAttributes().GetAttributesRef<float>(MeshAttribute::Edge::CreaseSharpness);
+	TVertexInstanceAttributesRef<FVector> VertexInstanceNormals = MeshDescription->VertexInstanceAttributes().GetAttributesRef<FVector>(MeshAttribute::VertexInstance::Normal);
+	TVertexInstanceAttributesRef<FVector> VertexInstanceTangents = MeshDescription->VertexInstanceAttributes().GetAttributesRef<FVector>(MeshAttribute::VertexInstance::Tangent);
+	TVertexInstanceAttributesRef<float> VertexInstanceBinormalSigns = MeshDescription->VertexInstanceAttributes().GetAttributesRef<float>(MeshAttribute::VertexInstance::BinormalSign);
+	TVertexInstanceAttributesRef<FVector2D> VertexInstanceUVs = MeshDescription->VertexInstanceAttributes().GetAttributesRef<FVector2D>(MeshAttribute::VertexInstance::TextureCoordinate);
+
+	// Normals and tangents are only kept when every piece has them, otherwise the whole mesh recomputes them.
+	LODDescription.bHasNormals = true;
+	LODDescription.bHasTangents = true;
+	for (int32 PieceIndex : Chunk.PieceIndices)
+	{
+		OGEX::MeshStructure* MeshStruct = Pieces[PieceIndex].MeshStruct;
+		LODDescription.bHasNormals &= MeshStruct->GetVertexArray(OGEX::kVertexAttribNormal) != nullptr;
+		LODDescription.bHasTangents &= MeshStruct->GetVertexArray(OGEX::kVertexAttribTangent) != nullptr;
+
+		int32 NumUVs = 0;
+		while (NumUVs < FMath::Min<int32>(OGEX::kMaxVertexAttribIndex, MAX_MESH_TEXTURE_COORDS_MD) && MeshStruct->GetVertexArray(OGEX::kVertexAttribTexcoord, NumUVs))
 		{
-			FVertexID VertexID = MeshDescription->CreateVertex();
-			VertexPositions[VertexID] = ConvertOpenGEXFloat3(PositionVertexArrayStruct->GetDataStructure()->GetArrayDataElement(i));
-			PositionIndexToVertexID.Add(i, VertexID);
+			++NumUVs;
 		}
+		LODDescription.NumUVs = FMath::Max(LODDescription.NumUVs, NumUVs);
+	}
+	LODDescription.bHasTangents &= LODDescription.bHasNormals;
 
-		//TArray<FVector2D> UVs[MAX_MESH_TEXTURE_COORDS_MD];
-		//for (int32 UVIndex = 0; UVIndex < NumUVs; ++UVIndex)
-		//{
-		//	for (int32 i = 0; i < TexcoordVertexArrayStructs[UVIndex]->GetDataStructure()->GetDataElementCount(); ++i)
-		//	{
-		//		UVs[UVIndex].Add(ConvertOpenGEXFloat2(TexcoordVertexArrayStructs[UVIndex]->GetDataStructure()->GetArrayDataElement(i)));
-		//	}
-		//}
+	const int32 NumUVs = FMath::Max(LODDescription.NumUVs, 1);
+	LODDescription.bDidGenerateTexCoords = (LODDescription.NumUVs == 0);
+	VertexInstanceUVs.SetNumIndices(NumUVs);
 
-		Array<OGEX::IndexArrayStructure*>& Primitives = MeshStruct->GetIndexArrayStructures();
-		for (int32 PrimIndex = 0; PrimIndex < Primitives.GetElementCount(); ++PrimIndex)
+	const FPolygonGroupID PolygonGroupID = MeshDescription->CreatePolygonGroup();
+	LODDescription.MaterialIndices.Add(0);
+	LODDescription.PolygonGroupIDs.Add(PolygonGroupID);
+
+	MeshDescription->ReserveNewVertexInstances(Chunk.NumVertexInstances);
+	MeshDescription->ReserveNewPolygons(Chunk.NumVertexInstances / 3);
+
+	TArray<FVector> Positions;
+	TArray<FVector> Normals;
+	TArray<FVector> Tangents;
+	TArray<FVertexID> VertexIDs;
+	TArray<FMeshDescription::FContourPoint> Contours;
+
+	for (int32 PieceIndex : Chunk.PieceIndices)
+	{
+		const FOpenGEXMergePiece& Piece = Pieces[PieceIndex];
+		OGEX::MeshStructure* MeshStruct = Piece.MeshStruct;
+
+		TransformOpenGEXVertexArray(MeshStruct->GetVertexArray(OGEX::kVertexAttribPosition), Piece.PositionMatrix, false, Positions);
+		if (LODDescription.bHasNormals)
 		{
-			OGEX::IndexArrayStructure* Prim = Primitives[PrimIndex];
-			FPolygonGroupID CurrentPolygonGroupID = MaterialIndexToPolygonGroupID[Prim->GetMaterialIndex()];
-			uint32 TriCount = Prim->GetIndicesArray().GetElementCount() / 3;
-
-			//TSet<uint32> UniqueIndices;
-			//for (int32 i = 0; i < Prim->GetIndicesArray().GetElementCount(); ++i)
-			//{
-			//	UniqueIndices.Add(Prim->GetIndicesArray()[i]);
-			//}
-			
-			Array<uint32>& Indices = Prim->GetIndicesArray();
-			TArray<FVector> Normals;
-
-			if (NormalVertexArrayStruct)
-			{
-				Normals = ReIndexForOpenGEX<FVector>(NormalVertexArrayStruct, Indices);
-			}
+			TransformOpenGEXVertexArray(MeshStruct->GetVertexArray(OGEX::kVertexAttribNormal), Piece.NormalMatrix, true, Normals);
+		}
+		if (LODDescription.bHasTangents)
+		{
+			TransformOpenGEXVertexArray(MeshStruct->GetVertexArray(OGEX::kVertexAttribTangent), Piece.PositionMatrix, true, Tangents);
+		}
 
-			TArray<FVector> Tangents;
-			if (TangentVertexArrayStruct)
-			{
-				Tangents = ReIndexForOpenGEX<FVector>(TangentVertexArrayStruct, Indices);
-			}
+		OGEX::VertexArrayStructure* TexcoordVertexArrayStructs[MAX_MESH_TEXTURE_COORDS_MD] = {};
+		for (int32 UVIndex = 0; UVIndex < NumUVs && UVIndex < OGEX::kMaxVertexAttribIndex; ++UVIndex)
+		{
+			TexcoordVertexArrayStructs[UVIndex] = MeshStruct->GetVertexArray(OGEX::kVertexAttribTexcoord, UVIndex);
+		}
 
-			TArray<FVector2D> UVs[MAX_MESH_TEXTURE_COORDS_MD];
+		// Only the vertices this index array uses are added, other materials of the node go to other chunks.
+		VertexIDs.Init(FVertexID::Invalid, Positions.Num());
 
-			if (NumUVs <= 0)
-			{
-				UVs[0].AddZeroed(Indices.GetElementCount());
-				bDidGenerateTexCoords = true;
-				NumUVs = 1;
-				VertexInstanceUVs.SetNumIndices(NumUVs);
-			}
-			else
+		Array<uint32>& Indices = Piece.Prim->GetIndicesArray();
+		for (int32 TriangleStart = 0; TriangleStart + 2 < Indices.GetElementCount(); TriangleStart += 3)
+		{
+			FVertexInstanceID CornerVertexInstanceIDs[3];
+			FVertexID CornerVertexIDs[3];
+			for (int32 Corner = 0; Corner < 3; ++Corner)
 			{
-				for (int32 UVIndex = 0; UVIndex < NumUVs; ++UVIndex)
+				const uint32 VertexIndex = Indices[TriangleStart + (Piece.bFlipWinding ? (3 - Corner) % 3 : Corner)];
+
+				FVertexID& VertexID = VertexIDs[VertexIndex];
+				if (VertexID == FVertexID::Invalid)
 				{
-					UVs[UVIndex] = ReIndexForOpenGEX<FVector2D>(TexcoordVertexArrayStructs[UVIndex], Indices);
+					VertexID = MeshDescription->CreateVertex();
+					VertexPositions[VertexID] = Positions[VertexIndex];
 				}
-			}
 
-			for (uint32 TriangleIndex = 0; TriangleIndex < TriCount; ++TriangleIndex)
-			{
-				FVertexInstanceID CornerVertexInstanceIDs[3];
-				FVertexID CornerVertexIDs[3];
-				for (int32 Corner = 0; Corner < 3; ++Corner)
+				const FVertexInstanceID VertexInstanceID = MeshDescription->CreateVertexInstance(VertexID);
+				if (LODDescription.bHasNormals)
 				{
-					uint32 IndicesIndex = TriangleIndex * 3 + Corner;
-					int32 VertexIndex = Indices[IndicesIndex];
-
-					FVertexID VertexID = PositionIndexToVertexID[VertexIndex];
-					const FVertexInstanceID& VertexInstanceID = MeshDescription->CreateVertexInstance(VertexID);
-
-					if (Tangents.Num() > 0)
-					{
-						VertexInstanceTangents[VertexInstanceID] = Tangents[IndicesIndex];
-					}
-					if (Normals.Num() > 0)
-					{
-						VertexInstanceNormals[VertexInstanceID] = Normals[IndicesIndex];
-					}
-
-					if (Tangents.Num() > 0 && Normals.Num() > 0)
-					{
-						VertexInstanceBinormalSigns[VertexInstanceID] = GetBasisDeterminantSign(VertexInstanceTangents[VertexInstanceID].GetSafeNormal(),
-							(VertexInstanceNormals[VertexInstanceID] ^ VertexInstanceTangents[VertexInstanceID]).GetSafeNormal(),
-							VertexInstanceNormals[VertexInstanceID].GetSafeNormal());
-					}
-
-					for (int32 UVIndex = 0; UVIndex < NumUVs; ++UVIndex)
-					{
-						VertexInstanceUVs.Set(VertexInstanceID, UVIndex, UVs[UVIndex][IndicesIndex]);
-					}
-
-					CornerVertexInstanceIDs[Corner] = VertexInstanceID;
-					CornerVertexIDs[Corner] = VertexID;
+					VertexInstanceNormals[VertexInstanceID] = Normals[VertexIndex];
+				}
+				if (LODDescription.bHasTangents)
+				{
+					VertexInstanceTangents[VertexInstanceID] = Tangents[VertexIndex];
+					VertexInstanceBinormalSigns[VertexInstanceID] = GetBasisDeterminantSign(Tangents[VertexIndex], (Normals[VertexIndex] ^ Tangents[VertexIndex]).GetSafeNormal(), Normals[VertexIndex]);
 				}
 
-				TArray<FMeshDescription::FContourPoint> Contours;
-				for (int32 Corner = 0; Corner < 3; ++Corner)
+				for (int32 UVIndex = 0; UVIndex < NumUVs; ++UVIndex)
 				{
-					int32 ContourPointIndex = Contours.AddDefaulted();
-					FMeshDescription::FContourPoint& ContourPoint = Contours[ContourPointIndex];
-					// Find the matching edge ID
-					uint32 CornerIndices[2];
-					CornerIndices[0] = (Corner + 0) % 3;
-					CornerIndices[1] = (Corner + 1) % 3;
-
-					FVertexID EdgeVertexIDs[2];
-					EdgeVertexIDs[0] = CornerVertexIDs[CornerIndices[0]];
-					EdgeVertexIDs[1] = CornerVertexIDs[CornerIndices[1]];
-
-					FEdgeID MatchEdgeID = MeshDescription->GetVertexPairEdge(EdgeVertexIDs[0], EdgeVertexIDs[1]);
-					if (MatchEdgeID == FEdgeID::Invalid)
-					{
-						MatchEdgeID = MeshDescription->CreateEdge(EdgeVertexIDs[0], EdgeVertexIDs[1]);
-						EdgeHardnesses[MatchEdgeID] = false;
-						EdgeCreaseSharpnesses[MatchEdgeID] = 0.0f;
-					}
-					ContourPoint.EdgeID = MatchEdgeID;
-					ContourPoint.VertexInstanceID = CornerVertexInstanceIDs[CornerIndices[0]];
+					const FVector2D UV = TexcoordVertexArrayStructs[UVIndex] ? ConvertOpenGEXFloat2(TexcoordVertexArrayStructs[UVIndex]->GetDataStructure()->GetArrayDataElement(VertexIndex)) : FVector2D::ZeroVector;
+					VertexInstanceUVs.Set(VertexInstanceID, UVIndex, UV);
 				}
 
-				const FPolygonID NewPolygonID = MeshDescription->CreatePolygon(CurrentPolygonGroupID, Contours);
-				FMeshPolygon& Polygon = MeshDescription->GetPolygon(NewPolygonID);
-				MeshDescription->ComputePolygonTriangulation(NewPolygonID, Polygon.Triangles);
+				CornerVertexInstanceIDs[Corner] = VertexInstanceID;
+				CornerVertexIDs[Corner] = VertexID;
 			}
+
+			AddTriangleForOpenGEX(MeshDescription, EdgeHardnesses, EdgeCreaseSharpnesses, PolygonGroupID, CornerVertexInstanceIDs, CornerVertexIDs, Contours);
 		}
+	}
 
-		MeshStruct = MeshStruct->Next();
+	OPENGEX_IMPORT_COUNT(Vertices, MeshDescription->VertexInstances().Num());
+	OPENGEX_IMPORT_COUNT(Triangles, MeshDescription->Polygons().Num());
+}
 
-		StaticMesh->CommitOriginalMeshDescription(LODIndex);
-	}
+static UStaticMesh* CreateMergedStaticMeshFromOpenGEX(FOpenGEXMergeChunk& Chunk, UPackage* AssetPackage, const FString& AssetName, const FString& FileName, EObjectFlags Flags)
+{
+	check(IsInGameThread());
+
+	// Merged meshes are rebuilt on every import, since any of their many nodes may have moved.
+	UStaticMesh* StaticMesh = NewObject<UStaticMesh>(AssetPackage, FName(*AssetName), Flags);
+	StaticMesh->AssetImportData = UOpenGEXAssetImportData::Create(StaticMesh, FileName, FString());
+	StaticMesh->AddSourceModel();
+
+	FOpenGEXMeshLODDescription& LODDescription = Chunk.LODDescription;
+	FMeshBuildSettings& Settings = StaticMesh->SourceModels[0].BuildSettings;
+	Settings.bRecomputeNormals = !LODDescription.bHasNormals;
+	Settings.bRecomputeTangents = !LODDescription.bHasTangents;
+	Settings.bUseMikkTSpace = true;
+	Settings.bRemoveDegenerates = false;
+	Settings.bBuildAdjacencyBuffer = false;
+	Settings.bBuildReversedIndexBuffer = false;
+	Settings.bUseHighPrecisionTangentBasis = false;
+	Settings.bUseFullPrecisionUVs = false;
+	Settings.bGenerateLightmapUVs = (LODDescription.NumUVs <= 1);
+
+	const FName MatName(Chunk.MaterialStruct ? Chunk.MaterialStruct->GetMaterialName() : "");
+	const int32 MeshSlot = StaticMesh->StaticMaterials.Emplace(Chunk.Material, MatName, MatName);
+	StaticMesh->SectionInfoMap.Set(0, MeshSlot, FMeshSectionInfo(MeshSlot));
 
-	StaticMesh->PostEditChange();
+	FMeshDescription* MeshDescription = StaticMesh->CreateOriginalMeshDescription(0);
+	*MeshDescription = MoveTemp(LODDescription.MeshDescription);
+
+	TPolygonGroupAttributesRef<FName> PolygonGroupImportedMaterialSlotNames = MeshDescription->PolygonGroupAttributes().GetAttributesRef<FName>(MeshAttribute::PolygonGroup::ImportedMaterialSlotName);
+	PolygonGroupImportedMaterialSlotNames[LODDescription.PolygonGroupIDs[0]] = MatName;
+
+	StaticMesh->CommitOriginalMeshDescription(0);
 
 	AssetPackage->SetDirtyFlag(true);
-	FAssetRegistryModule::AssetCreated(StaticMesh);
 
 	return StaticMesh;
 }
 
-TArray<UStaticMesh*> ImportMeshesFromOpenGEX(OGEX::OpenGexDataDescription* OpenGexDataDescriptionPtr, const TMap<FName, UMaterial*>& Materials, const FString& FileName, UObject* InParent, FName InName, EObjectFlags Flags, FFeedbackContext* Warn)
+// Whether a node is small enough to have its base LOD merged with its neighbors instead of becoming its own asset.
+static bool ShouldMergeOpenGEXGeometryNode(OGEX::GeometryNodeStructure* GeometryNode, int32 VertexLimit)
+{
+	OGEX::GeometryObjectStructure* GeometryObject = GeometryNode->geometryObjectStructure;
+	OGEX::MeshStructure* MeshStruct = GeometryObject ? GeometryObject->GetMeshMap()->First() : nullptr;
+	return MeshStruct && MeshStruct->GetVertexArray(OGEX::kVertexAttribPosition) && GetOpenGEXVertexCount(MeshStruct) <= VertexLimit;
+}
+
+// Bakes the transforms of the given nodes into their geometry and merges it into one static mesh per material and grid
+// cell, split further whenever a mesh would go over the corner budget. The meshes are created but not built yet.
+static TArray<UStaticMesh*> ImportMergedMeshesFromOpenGEX(OGEX::OpenGexDataDescription* OpenGexDataDescriptionPtr, const TArray<OGEX::GeometryNodeStructure*>& MergeNodes, FOpenGEXMaterialImporter& MaterialImporter, FOpenGEXAssetNameCache& NameCache, const FString& FileName, UObject* InParent, FName InName, EObjectFlags Flags)
 {
 	TArray<UStaticMesh*> Result;
 
-	int32 Index = 0;
+	const UOpenGEXImportSettings* Settings = GetDefault<UOpenGEXImportSettings>();
+	const float CellSize = FMath::Max(Settings->MergeCellSize, 1.0f);
+	const int32 CornerBudget = FMath::Max(Settings->MergedMeshCornerBudget, 3);
+	const FOpenGEXSpaceConversion Conversion(OpenGexDataDescriptionPtr);
 
-	Structure* StructureNode = OpenGexDataDescriptionPtr->GetRootStructure()->GetFirstSubnode();
-	for (; StructureNode; StructureNode = StructureNode->Next())
+	TArray<FOpenGEXMergePiece> Pieces;
+	TArray<FOpenGEXMergeChunk> Chunks;
+	TMap<TPair<UMaterialInterface*, FIntVector>, int32> OpenChunkIndices;
+
+	for (OGEX::GeometryNodeStructure* GeometryNode : MergeNodes)
 	{
-		if (StructureNode->GetStructureType() == OGEX::kStructureGeometryNode)
+		OGEX::MeshStructure* MeshStruct = GeometryNode->geometryObjectStructure->GetMeshMap()->First();
+
+		const FMatrix WorldMatrix = Conversion.ConvertTransform(GeometryNode->GetObjectTransform()) * Conversion.ConvertTransform(GeometryNode->GetGlobalTransform());
+		const FVector Origin = WorldMatrix.GetOrigin();
+		const FIntVector Cell(FMath::FloorToInt(Origin.X / CellSize), FMath::FloorToInt(Origin.Y / CellSize), FMath::FloorToInt(Origin.Z / CellSize));
+
+		Array<OGEX::IndexArrayStructure*>& Primitives = MeshStruct->GetIndexArrayStructures();
+		for (int32 PrimIndex = 0; PrimIndex < Primitives.GetElementCount(); ++PrimIndex)
 		{
-			OGEX::GeometryNodeStructure* GeometryNode = static_cast<OGEX::GeometryNodeStructure*>(StructureNode);
-			UStaticMesh* RetStaticMesh = ImportOneMeshFromOpenGEX(OpenGexDataDescriptionPtr, GeometryNode, Materials, FileName, InParent, InName, Flags, Warn, Index);
-			if (RetStaticMesh)
+			OGEX::IndexArrayStructure* Prim = Primitives[PrimIndex];
+			const int32 NumVertexInstances = Prim->GetIndicesArray().GetElementCount();
+			if (NumVertexInstances < 3)
+				continue;
+
+			const int32 MaterialIndex = Prim->GetMaterialIndex();
+			OGEX::MaterialStructure* MaterialStruct = (MaterialIndex < GeometryNode->materialStructureArray.GetElementCount()) ? GeometryNode->materialStructureArray[MaterialIndex] : nullptr;
+			UMaterialInterface* Material = MaterialStruct ? MaterialImporter.GetOrImportMaterial(MaterialStruct) : nullptr;
+
+			FOpenGEXMergePiece& Piece = Pieces.AddDefaulted_GetRef();
+			Piece.MeshStruct = MeshStruct;
+			Piece.Prim = Prim;
+			Piece.PositionMatrix = Conversion.Matrix * WorldMatrix;
+			Piece.NormalMatrix = Conversion.NormalMatrix * WorldMatrix.Inverse().GetTransposed();
+			Piece.bFlipWinding = Conversion.bFlipWinding != (WorldMatrix.Determinant() < 0.0f);
+
+			int32& ChunkIndex = OpenChunkIndices.FindOrAdd(TPair<UMaterialInterface*, FIntVector>(Material, Cell), INDEX_NONE);
+			if (ChunkIndex == INDEX_NONE || Chunks[ChunkIndex].NumVertexInstances + NumVertexInstances > CornerBudget)
 			{
-				Result.Add(RetStaticMesh);
+				const int32 SplitIndex = (ChunkIndex == INDEX_NONE) ? 0 : Chunks[ChunkIndex].SplitIndex + 1;
+
+				ChunkIndex = Chunks.AddDefaulted();
+				Chunks[ChunkIndex].Material = Material;
+				Chunks[ChunkIndex].MaterialStruct = MaterialStruct;
+				Chunks[ChunkIndex].Cell = Cell;
+				Chunks[ChunkIndex].SplitIndex = SplitIndex;
 			}
-			Index += 1;
+
+			Chunks[ChunkIndex].PieceIndices.Add(Pieces.Num() - 1);
+			Chunks[ChunkIndex].NumVertexInstances += NumVertexInstances;
 		}
 	}
 
+	ParallelFor(Chunks.Num(), [&](int32 ChunkIndex)
+	{
+		BuildMergedMeshDescriptionFromOpenGEX(Pieces, Chunks[ChunkIndex]);
+	});
+
+	UE_LOG(LogOpenGEXImporter, Log, TEXT("Merged %d nodes into %d meshes"), MergeNodes.Num(), Chunks.Num());
+
+	for (int32 ChunkIndex = 0; ChunkIndex < Chunks.Num(); ++ChunkIndex)
+	{
+		FOpenGEXMergeChunk& Chunk = Chunks[ChunkIndex];
+		const FString MaterialName = Chunk.Material ? Chunk.Material->GetName() : FString(TEXT("Default"));
+
+		// Named after what the chunk holds rather than its position in the list, so a reimport replaces the same
+		// assets even when chunks elsewhere in the scene appear or disappear.
+		const FString PreferredName = FString::Printf(TEXT("%s_Merged_%s_%d_%d_%d_%d"), *InName.ToString(), *MaterialName, Chunk.Cell.X, Chunk.Cell.Y, Chunk.Cell.Z, Chunk.SplitIndex);
+
+		FString AssetName;
+		UPackage* AssetPackage = RetrieveAssetPackageAndName<UStaticMesh>(NameCache, InParent, PreferredName, TEXT("SM"), InName, ChunkIndex, AssetName);
+
+		Result.Add(CreateMergedStaticMeshFromOpenGEX(Chunk, AssetPackage, AssetName, FileName, Flags));
+		Chunk.LODDescription = FOpenGEXMeshLODDescription();
+	}
+
 	return Result;
 }
 
-bool HasTangentFromOpenGEXMeshStructure(OGEX::MeshStructure* MeshStruct)
+UStaticMesh* ImportOneMeshFromOpenGEX(OGEX::OpenGexDataDescription* OpenGexDataDescriptionPtr, OGEX::GeometryNodeStructure* GeometryNode, FOpenGEXMaterialImporter& MaterialImporter, FOpenGEXAssetNameCache& NameCache, const FString& FileName, UObject* InParent, FName InName, EObjectFlags Flags, FFeedbackContext* Warn, int32 Index)
+{
+	if (!GeometryNode->geometryObjectStructure)
+		return nullptr;
+
+	const FString ContentHash = ComputeStaticMeshContentHashForOpenGEX(GeometryNode, HashGeometryObjectForOpenGEX(GeometryNode->geometryObjectStructure), FOpenGEXSpaceConversion(OpenGexDataDescriptionPtr));
+
+	FString AssetName;
+	UPackage* AssetPackage = RetrieveAssetPackageAndName<UStaticMesh>(NameCache, InParent, UTF8_TO_TCHAR(GeometryNode->GetNodeName()), TEXT("SM"), InName, Index, AssetName);
+
+	if (UStaticMesh* UnchangedStaticMesh = FindUnchangedOpenGEXAsset<UStaticMesh>(AssetPackage, AssetName, ContentHash))
+	{
+		return UnchangedStaticMesh;
+	}
+
+	FOpenGEXGeometryDescription GeometryDescription;
+	BuildGeometryDescriptionFromOpenGEX(OpenGexDataDescriptionPtr, GeometryNode->geometryObjectStructure, GeometryDescription);
+
+	UStaticMesh* StaticMesh = CreateStaticMeshFromOpenGEX(OpenGexDataDescriptionPtr, GeometryNode, GeometryDescription, true, MaterialImporter, AssetPackage, AssetName, FileName, ContentHash, Flags);
+	BuildStaticMeshesForOpenGEX({ StaticMesh });
+
+	return StaticMesh;
+}
+
+TArray<UStaticMesh*> ImportMeshesFromOpenGEX(OGEX::OpenGexDataDescription* OpenGexDataDescriptionPtr, FOpenGEXMaterialImporter& MaterialImporter, FOpenGEXAssetNameCache& NameCache, const FString& FileName, UObject* InParent, FName InName, EObjectFlags Flags, FFeedbackContext* Warn, bool bShareIdenticalMeshes, TMap<OGEX::GeometryNodeStructure*, UStaticMesh*>* OutNodeMeshes, TArray<UStaticMesh*>* OutMergedMeshes)
 {
-	bool bHasTangentResult = false;
+	TArray<UStaticMesh*> Result;
+
+	const UOpenGEXImportSettings* Settings = GetDefault<UOpenGEXImportSettings>();
+
+	TArray<OGEX::GeometryNodeStructure*> GeometryNodes;
+	TArray<OGEX::GeometryNodeStructure*> MergeNodes;
+	TArray<int32> NodeGeometryIndices;
+	TArray<OGEX::GeometryObjectStructure*> GeometryObjects;
+	TMap<OGEX::GeometryObjectStructure*, int32> GeometryObjectIndices;
+
+	for (OGEX::GeometryNodeStructure* GeometryNode : GatherOpenGEXGeometryNodes(OpenGexDataDescriptionPtr))
+	{
+		OGEX::GeometryObjectStructure* GeometryObject = GeometryNode->geometryObjectStructure;
+
+		// Skinned nodes are imported as skeletal meshes by ImportSkeletalMeshesFromOpenGEX.
+		if (IsSkinnedOpenGEXGeometryNode(GeometryNode))
+			continue;
+
+		if (Settings->bMergeSmallNodes && ShouldMergeOpenGEXGeometryNode(GeometryNode, Settings->MergeNodeVertexLimit))
+		{
+			MergeNodes.Add(GeometryNode);
+			continue;
+		}
+
+		int32 GeometryIndex = INDEX_NONE;
+		if (GeometryObject)
+		{
+			int32* FoundIndex = GeometryObjectIndices.Find(GeometryObject);
+			if (FoundIndex)
+			{
+				GeometryIndex = *FoundIndex;
+			}
+			else
+			{
+				GeometryIndex = GeometryObjects.Add(GeometryObject);
+				GeometryObjectIndices.Add(GeometryObject, GeometryIndex);
+			}
+		}
+
+		GeometryNodes.Add(GeometryNode);
+		NodeGeometryIndices.Add(GeometryIndex);
+	}
 
-	Array<OGEX::VertexArrayStructure*>& VerteArrayStructures = MeshStruct->GetVertexArrayStructures();
-	TArray<int32> ReadyForRemoveIndices;
-	for (int32 i = 0; i < VerteArrayStructures.GetElementCount(); ++i)
+	TArray<FSHAHash> GeometryHashes;
+	GeometryHashes.SetNum(GeometryObjects.Num());
+	ParallelFor(GeometryObjects.Num(), [&](int32 GeometryIndex)
 	{
-		OGEX::VertexArrayStructure* VertexArrayStruct = VerteArrayStructures[i];
-		std::string AttribStr(VertexArrayStruct->GetArrayAttrib());
-		size_t SubPos = AttribStr.find("tangent");
-		if (SubPos != std::string::npos)
+		GeometryHashes[GeometryIndex] = HashGeometryObjectForOpenGEX(GeometryObjects[GeometryIndex]);
+	});
+
+	// Resolve every node's asset up front, in node order so naming stays deterministic. Meshes whose stored hash
+	// still matches are kept as they are and their geometry is never converted.
+	TArray<UPackage*> NodeAssetPackages;
+	TArray<FString> NodeAssetNames;
+	TArray<FString> NodeContentHashes;
+	TArray<UStaticMesh*> NodeUnchangedStaticMeshes;
+	TArray<int32> NodeSharedMeshIndices;
+	NodeAssetPackages.SetNumZeroed(GeometryNodes.Num());
+	NodeAssetNames.SetNum(GeometryNodes.Num());
+	NodeContentHashes.SetNum(GeometryNodes.Num());
+	NodeUnchangedStaticMeshes.SetNumZeroed(GeometryNodes.Num());
+	NodeSharedMeshIndices.Init(INDEX_NONE, GeometryNodes.Num());
+
+	const FOpenGEXSpaceConversion Conversion(OpenGexDataDescriptionPtr);
+
+	// Maps a content hash to the first node with that content, whose asset later nodes share.
+	TMap<FString, int32> ContentHashNodeIndices;
+
+	TArray<int32> GeometryUseCounts;
+	GeometryUseCounts.SetNumZeroed(GeometryObjects.Num());
+
+	for (int32 Index = 0; Index < GeometryNodes.Num(); ++Index)
+	{
+		const int32 GeometryIndex = NodeGeometryIndices[Index];
+		if (GeometryIndex == INDEX_NONE)
+			continue;
+
+		NodeContentHashes[Index] = ComputeStaticMeshContentHashForOpenGEX(GeometryNodes[Index], GeometryHashes[GeometryIndex], Conversion);
+
+		if (bShareIdenticalMeshes)
+		{
+			if (const int32* SharedIndex = ContentHashNodeIndices.Find(NodeContentHashes[Index]))
+			{
+				NodeSharedMeshIndices[Index] = *SharedIndex;
+				continue;
+			}
+
+			ContentHashNodeIndices.Add(NodeContentHashes[Index], Index);
+		}
+
+		NodeAssetPackages[Index] = RetrieveAssetPackageAndName<UStaticMesh>(NameCache, InParent, UTF8_TO_TCHAR(GeometryNodes[Index]->GetNodeName()), TEXT("SM"), InName, Index, NodeAssetNames[Index]);
+		NodeUnchangedStaticMeshes[Index] = FindUnchangedOpenGEXAsset<UStaticMesh>(NodeAssetPackages[Index], NodeAssetNames[Index], NodeContentHashes[Index]);
+
+		if (!NodeUnchangedStaticMeshes[Index])
 		{
-			bHasTangentResult = true;
-			break;
+			GeometryUseCounts[GeometryIndex] += 1;
 		}
 	}
 
-	return bHasTangentResult;
+	// Every geometry object that still needs converting is handled on the task graph while the game thread creates
+	// assets in node order, so asset creation overlaps with the remaining conversions.
+	TArray<FOpenGEXGeometryDescription> GeometryDescriptions;
+	GeometryDescriptions.SetNum(GeometryObjects.Num());
+
+	TArray<FGraphEventRef> GeometryTasks;
+	GeometryTasks.SetNum(GeometryObjects.Num());
+	for (int32 GeometryIndex = 0; GeometryIndex < GeometryObjects.Num(); ++GeometryIndex)
+	{
+		if (GeometryUseCounts[GeometryIndex] == 0)
+			continue;
+
+		OGEX::GeometryObjectStructure* GeometryObject = GeometryObjects[GeometryIndex];
+		FOpenGEXGeometryDescription* GeometryDescription = &GeometryDescriptions[GeometryIndex];
+		GeometryTasks[GeometryIndex] = FFunctionGraphTask::CreateAndDispatchWhenReady([OpenGexDataDescriptionPtr, GeometryObject, GeometryDescription]()
+		{
+			BuildGeometryDescriptionFromOpenGEX(OpenGexDataDescriptionPtr, GeometryObject, *GeometryDescription);
+		}, TStatId(), nullptr, ENamedThreads::AnyThread);
+	}
+
+	// Decode the textures of every material the nodes reference while the geometry is being converted.
+	// Unchanged meshes still pass their materials through, since those may have changed on their own.
+	TArray<OGEX::MaterialStructure*> ReferencedMaterials;
+	TSet<OGEX::MaterialStructure*> SeenMaterials;
+	for (int32 Index = 0; Index < GeometryNodes.Num(); ++Index)
+	{
+		if (NodeGeometryIndices[Index] != INDEX_NONE)
+		{
+			CollectReferencedMaterialsForOpenGEX(GeometryNodes[Index], ReferencedMaterials, SeenMaterials);
+		}
+	}
+	for (OGEX::GeometryNodeStructure* GeometryNode : MergeNodes)
+	{
+		CollectReferencedMaterialsForOpenGEX(GeometryNode, ReferencedMaterials, SeenMaterials);
+	}
+	MaterialImporter.PreloadTextures(ReferencedMaterials);
+
+	TArray<UStaticMesh*> StaticMeshesToBuild;
+	TArray<UStaticMesh*> NodeStaticMeshes;
+	NodeStaticMeshes.SetNumZeroed(GeometryNodes.Num());
+
+	for (int32 Index = 0; Index < GeometryNodes.Num(); ++Index)
+	{
+		const int32 GeometryIndex = NodeGeometryIndices[Index];
+		if (GeometryIndex == INDEX_NONE)
+			continue;
+
+		if (NodeSharedMeshIndices[Index] != INDEX_NONE)
+		{
+			NodeStaticMeshes[Index] = NodeStaticMeshes[NodeSharedMeshIndices[Index]];
+			continue;
+		}
+
+		if (NodeUnchangedStaticMeshes[Index])
+		{
+			NodeStaticMeshes[Index] = NodeUnchangedStaticMeshes[Index];
+			Result.Add(NodeUnchangedStaticMeshes[Index]);
+			continue;
+		}
+
+		FTaskGraphInterface::Get().WaitUntilTaskCompletes(GeometryTasks[GeometryIndex], ENamedThreads::GameThread_Local);
+
+		// The last node referencing a geometry object takes its descriptions, earlier ones get copies.
+		const bool bConsumeDescription = (--GeometryUseCounts[GeometryIndex] == 0);
+		UStaticMesh* RetStaticMesh = CreateStaticMeshFromOpenGEX(OpenGexDataDescriptionPtr, GeometryNodes[Index], GeometryDescriptions[GeometryIndex], bConsumeDescription, MaterialImporter, NodeAssetPackages[Index], NodeAssetNames[Index], FileName, NodeContentHashes[Index], Flags);
+		if (bConsumeDescription)
+		{
+			GeometryDescriptions[GeometryIndex].LODDescriptions.Empty();
+		}
+
+		if (RetStaticMesh)
+		{
+			NodeStaticMeshes[Index] = RetStaticMesh;
+			Result.Add(RetStaticMesh);
+			StaticMeshesToBuild.Add(RetStaticMesh);
+		}
+	}
+
+	if (OutNodeMeshes)
+	{
+		for (int32 Index = 0; Index < GeometryNodes.Num(); ++Index)
+		{
+			if (NodeStaticMeshes[Index])
+			{
+				OutNodeMeshes->Add(GeometryNodes[Index], NodeStaticMeshes[Index]);
+			}
+		}
+	}
+
+	if (MergeNodes.Num() > 0)
+	{
+		TArray<UStaticMesh*> MergedMeshes = ImportMergedMeshesFromOpenGEX(OpenGexDataDescriptionPtr, MergeNodes, MaterialImporter, NameCache, FileName, InParent, InName, Flags);
+		Result.Append(MergedMeshes);
+		StaticMeshesToBuild.Append(MergedMeshes);
+
+		if (OutMergedMeshes)
+		{
+			OutMergedMeshes->Append(MergedMeshes);
+		}
+	}
+
+	for (OGEX::MaterialStructure* MaterialStruct : ReferencedMaterials)
+	{
+		MaterialImporter.GetOrImportMaterial(MaterialStruct);
+	}
+
+	BuildStaticMeshesForOpenGEX(StaticMeshesToBuild);
+
+	return Result;
+}
+
+bool HasTangentFromOpenGEXMeshStructure(OGEX::MeshStructure* MeshStruct)
+{
+	return MeshStruct->GetVertexArray(OGEX::kVertexAttribTangent) != nullptr;
 }
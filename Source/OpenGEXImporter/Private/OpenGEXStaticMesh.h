@@ -7,9 +7,15 @@
 #include "OpenGEX.h"
 
 class UStaticMesh;
-class UMaterial;
+class FOpenGEXMaterialImporter;
+class FOpenGEXAssetNameCache;
 
-UStaticMesh* ImportOneMeshFromOpenGEX(OGEX::OpenGexDataDescription* OpenGexDataDescriptionPtr, OGEX::GeometryNodeStructure* GeometryNode, const TMap<FName, UMaterial*>& Materials, const FString& FileName, UObject* InParent, FName InName, EObjectFlags Flags, FFeedbackContext* Warn, int32 Index);
+UStaticMesh* ImportOneMeshFromOpenGEX(OGEX::OpenGexDataDescription* OpenGexDataDescriptionPtr, OGEX::GeometryNodeStructure* GeometryNode, FOpenGEXMaterialImporter& MaterialImporter, FOpenGEXAssetNameCache& NameCache, const FString& FileName, UObject* InParent, FName InName, EObjectFlags Flags, FFeedbackContext* Warn, int32 Index);
 
-TArray<UStaticMesh*> ImportMeshesFromOpenGEX(OGEX::OpenGexDataDescription* OpenGexDataDescriptionPtr, const TMap<FName, UMaterial*>& Materials, const FString& FileName, UObject* InParent, FName InName, EObjectFlags Flags, FFeedbackContext* Warn);
+/**
+ * Imports the static meshes of all unskinned geometry nodes. With bShareIdenticalMeshes, nodes whose geometry and material
+ * bindings hash the same share the first such node's asset. OutNodeMeshes, when given, receives the mesh of every node.
+ * Nodes merged by the bMergeSmallNodes setting are left out of it; their meshes are in world space and go to OutMergedMeshes.
+ */
+TArray<UStaticMesh*> ImportMeshesFromOpenGEX(OGEX::OpenGexDataDescription* OpenGexDataDescriptionPtr, FOpenGEXMaterialImporter& MaterialImporter, FOpenGEXAssetNameCache& NameCache, const FString& FileName, UObject* InParent, FName InName, EObjectFlags Flags, FFeedbackContext* Warn, bool bShareIdenticalMeshes = false, TMap<OGEX::GeometryNodeStructure*, UStaticMesh*>* OutNodeMeshes = nullptr, TArray<UStaticMesh*>* OutMergedMeshes = nullptr);
 
@@ -1 +1,144 @@
 #include "OpenGEXUtility.h"
+
+#include "AssetRegistryModule.h"
+
+FOpenGEXAssetNameCache::FOpenGEXAssetNameCache(UObject* InParent)
+{
+	check(IsInGameThread());
+
+	PackagePath = FPackageName::GetLongPackagePath(InParent->GetOutermost()->GetName());
+
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+	AssetRegistry.ScanPathsSynchronous({ PackagePath });
+
+	TArray<FAssetData> Assets;
+	AssetRegistry.GetAssetsByPath(FName(*PackagePath), Assets, false);
+
+	ExistingAssetClasses.Reserve(Assets.Num());
+	TakenPackageNames.Reserve(Assets.Num());
+	for (const FAssetData& Asset : Assets)
+	{
+		ExistingAssetClasses.Add(Asset.ObjectPath, Asset.AssetClass);
+		TakenPackageNames.Add(Asset.PackageName);
+	}
+}
+
+UPackage* FOpenGEXAssetNameCache::FindExistingAssetPackage(const FString& PackageName, const FString& AssetName, UClass* AssetClass) const
+{
+	const FString ObjectPath = PackageName + TEXT('.') + AssetName;
+
+	const FName* AssetClassName = ExistingAssetClasses.Find(FName(*ObjectPath));
+	if (!AssetClassName || *AssetClassName != AssetClass->GetFName())
+	{
+		return nullptr;
+	}
+
+	// Reimporting over an existing asset still needs it in memory, so it gets replaced in place.
+	UObject* ExistingAsset = StaticLoadObject(AssetClass, nullptr, *ObjectPath, nullptr, LOAD_Quiet | LOAD_NoWarn);
+	return ExistingAsset ? ExistingAsset->GetOutermost() : nullptr;
+}
+
+UPackage* FOpenGEXAssetNameCache::CreateUniqueAssetPackage(const FString& BasePackageName, FString& InOutAssetName)
+{
+	FString PackageName = BasePackageName;
+	FString AssetName = InOutAssetName;
+
+	for (int32 Suffix = 1; TakenPackageNames.Contains(FName(*PackageName)) || FindPackage(nullptr, *PackageName); ++Suffix)
+	{
+		AssetName = FString::Printf(TEXT("%s_%d"), *InOutAssetName, Suffix);
+		PackageName = FString::Printf(TEXT("%s_%d"), *BasePackageName, Suffix);
+	}
+
+	TakenPackageNames.Add(FName(*PackageName));
+
+	InOutAssetName = AssetName;
+	return CreatePackage(nullptr, *PackageName);
+}
+
+TArray<OGEX::GeometryNodeStructure*> GatherOpenGEXGeometryNodes(OGEX::OpenGexDataDescription* OpenGexDataDescriptionPtr)
+{
+	TArray<OGEX::GeometryNodeStructure*> Result;
+
+	// Only nodes can contain further nodes, so the walk skips over the contents of every other structure.
+	const Structure* RootStructure = OpenGexDataDescriptionPtr->GetRootStructure();
+	Structure* StructureNode = RootStructure->GetFirstSubnode();
+	while (StructureNode)
+	{
+		if (StructureNode->GetBaseStructureType() == OGEX::kStructureNode)
+		{
+			if (StructureNode->GetStructureType() == OGEX::kStructureGeometryNode)
+			{
+				Result.Add(static_cast<OGEX::GeometryNodeStructure*>(StructureNode));
+			}
+
+			StructureNode = RootStructure->GetNextNode(StructureNode);
+		}
+		else
+		{
+			StructureNode = RootStructure->GetNextLevelNode(StructureNode);
+		}
+	}
+
+	return Result;
+}
+
+// Returns the unit vector of an OpenGEX Metric direction such as "z" or "-x".
+static FVector GetOpenGEXMetricAxis(const char* Direction)
+{
+	const float Sign = (Direction[0] == '-') ? -1.0f : 1.0f;
+	const char Axis = Direction[(Direction[0] == '-') ? 1 : 0];
+	return FVector(Axis == 'x' ? Sign : 0.0f, Axis == 'y' ? Sign : 0.0f, Axis == 'z' ? Sign : 0.0f);
+}
+
+FOpenGEXSpaceConversion::FOpenGEXSpaceConversion(const OGEX::OpenGexDataDescription* OpenGexDataDescriptionPtr)
+{
+	const FVector Up = GetOpenGEXMetricAxis(OpenGexDataDescriptionPtr->GetUpDirection());
+	FVector Forward = GetOpenGEXMetricAxis(OpenGexDataDescriptionPtr->GetForwardDirection());
+	if (FMath::Abs(Forward | Up) > 0.5f)
+	{
+		// A forward direction along the up axis says nothing, so fall back to the default X.
+		Forward = (Up.X != 0.0f) ? FVector(0.0f, 0.0f, 1.0f) : FVector(1.0f, 0.0f, 0.0f);
+	}
+
+	// The file's axes go onto a right-handed Z up, X forward frame first, so the remap itself never mirrors.
+	const FVector Left = Up ^ Forward;
+	const FMatrix AxisMatrix(FPlane(Forward.X, Left.X, Up.X, 0.0f), FPlane(Forward.Y, Left.Y, Up.Y, 0.0f), FPlane(Forward.Z, Left.Z, Up.Z, 0.0f), FPlane(0.0f, 0.0f, 0.0f, 1.0f));
+
+	// Metric distances are in meters, Unreal units are centimeters.
+	const float Scale = OpenGexDataDescriptionPtr->GetDistanceScale() * 100.0f;
+
+	Matrix = AxisMatrix * FScaleMatrix(FVector(Scale, -Scale, Scale));
+	InverseMatrix = Matrix.Inverse();
+	NormalMatrix = InverseMatrix.GetTransposed();
+	bFlipWinding = (Scale < 0.0f);
+}
+
+void TransformOpenGEXVertexArray(OGEX::VertexArrayStructure* VertexArrayStruct, const FMatrix& Matrix, bool bDirections, TArray<FVector>& OutVectors)
+{
+	const DataStructure<FloatDataType>* Data = VertexArrayStruct->GetDataStructure();
+	const int32 Count = Data->GetDataElementCount() / FMath::Max<int32>(Data->GetArraySize(), 1);
+
+	const VectorRegister Row0 = VectorLoad(Matrix.M[0]);
+	const VectorRegister Row1 = VectorLoad(Matrix.M[1]);
+	const VectorRegister Row2 = VectorLoad(Matrix.M[2]);
+	const VectorRegister Row3 = bDirections ? VectorZero() : VectorLoad(Matrix.M[3]);
+
+	OutVectors.SetNumUninitialized(Count);
+	for (int32 Index = 0; Index < Count; ++Index)
+	{
+		const VectorRegister Vector = VectorLoadFloat3(Data->GetArrayDataElement(Index));
+
+		VectorRegister Result = VectorMultiplyAdd(VectorReplicate(Vector, 0), Row0, Row3);
+		Result = VectorMultiplyAdd(VectorReplicate(Vector, 1), Row1, Result);
+		Result = VectorMultiplyAdd(VectorReplicate(Vector, 2), Row2, Result);
+		VectorStoreFloat3(Result, &OutVectors[Index]);
+	}
+
+	if (bDirections)
+	{
+		for (FVector& Direction : OutVectors)
+		{
+			Direction = Direction.GetSafeNormal();
+		}
+	}
+}
@@ -6,9 +6,98 @@
 #include "Misc/PackageName.h"
 #include "ObjectTools.h"
 #include "AssetToolsModule.h"
+#include "OpenGEX.h"
+
+inline FVector2D ConvertOpenGEXFloat2(const float* InFloat2)
+{
+	return { InFloat2[0], InFloat2[1] };
+}
+
+/**
+ * The change of basis from an OpenGEX file into Unreal space, fused into one row-vector 3x3 matrix: the Metric distance
+ * scale into centimeters, the file's up and forward axes onto Z and X, and the negation of Y into Unreal's left-handed space.
+ */
+struct FOpenGEXSpaceConversion
+{
+	/** Takes positions and tangents into Unreal space. */
+	FMatrix Matrix;
+	FMatrix InverseMatrix;
+
+	/** Takes normals into Unreal space, before they get normalized again. */
+	FMatrix NormalMatrix;
+
+	/**
+	 * The Y negation mirrors the geometry together with the handedness, which keeps triangles facing the same way.
+	 * Any further mirroring, a negative distance scale, turns them inside out and is undone by swapping two corners.
+	 */
+	bool bFlipWinding;
+
+	explicit FOpenGEXSpaceConversion(const OGEX::OpenGexDataDescription* OpenGexDataDescriptionPtr);
+
+	FVector ConvertPosition(const float* InFloat3) const
+	{
+		return Matrix.TransformVector(FVector(InFloat3[0], InFloat3[1], InFloat3[2]));
+	}
+
+	FVector ConvertNormal(const float* InFloat3) const
+	{
+		return NormalMatrix.TransformVector(FVector(InFloat3[0], InFloat3[1], InFloat3[2])).GetSafeNormal();
+	}
+
+	// Converts a column-major OpenGEX transform into an FMatrix that does the same in Unreal space.
+	FMatrix ConvertTransform(const float* InFloat16) const
+	{
+		FMatrix Result;
+		for (int32 Row = 0; Row < 4; ++Row)
+		{
+			for (int32 Column = 0; Column < 4; ++Column)
+			{
+				Result.M[Row][Column] = InFloat16[Row * 4 + Column];
+			}
+		}
+		return InverseMatrix * Result * Matrix;
+	}
+};
+
+/**
+ * Transforms every element of a vertex array by a row-vector matrix in a single vectorized pass. Directions ignore the
+ * translation and come out normalized; pass the inverse transpose for normals.
+ */
+void TransformOpenGEXVertexArray(OGEX::VertexArrayStructure* VertexArrayStruct, const FMatrix& Matrix, bool bDirections, TArray<FVector>& OutVectors);
+
+/**
+ * Snapshot of the assets already present in an import's destination folder, taken once from the asset registry.
+ * Each import creates one and passes it to its importers, so RetrieveAssetPackageAndName resolves packages and
+ * allocates unique names in memory instead of probing the disk for every asset. Game thread only.
+ */
+class FOpenGEXAssetNameCache
+{
+public:
+	explicit FOpenGEXAssetNameCache(UObject* InParent);
+
+	const FString& GetPackagePath() const
+	{
+		return PackagePath;
+	}
+
+	/** Returns the package of an existing asset with this name and class, or nullptr. */
+	UPackage* FindExistingAssetPackage(const FString& PackageName, const FString& AssetName, UClass* AssetClass) const;
+
+	/** Creates the package for a new asset, appending a suffix to the name if it is taken. */
+	UPackage* CreateUniqueAssetPackage(const FString& BasePackageName, FString& InOutAssetName);
+
+private:
+	FString PackagePath;
+
+	/** Object path to class name of every asset found in the folder. */
+	TMap<FName, FName> ExistingAssetClasses;
+
+	/** Packages that exist in the folder or were created by this import. */
+	TSet<FName> TakenPackageNames;
+};
 
 template <typename T>
-UPackage* RetrieveAssetPackageAndName(UObject* Parent, const FString& PreferredName, const TCHAR* BackupPrefix, FName BackupName, int32 BackupIndex, FString& OutName)
+UPackage* RetrieveAssetPackageAndName(FOpenGEXAssetNameCache& NameCache, UObject* Parent, const FString& PreferredName, const TCHAR* BackupPrefix, FName BackupName, int32 BackupIndex, FString& OutName)
 {
 	FString AssetName;
 
@@ -25,7 +114,20 @@ UPackage* RetrieveAssetPackageAndName(UObject* Parent, const FString& PreferredN
 	AssetName = ObjectTools::SanitizeObjectName(AssetName);
 
 	// set where to place the static mesh
-	const FString BasePackageName = UPackageTools::SanitizePackageName(FPackageName::GetLongPackagePath(Parent->GetOutermost()->GetName()) / AssetName);
+	const FString PackagePath = FPackageName::GetLongPackagePath(Parent->GetOutermost()->GetName());
+	const FString BasePackageName = UPackageTools::SanitizePackageName(PackagePath / AssetName);
+
+	if (NameCache.GetPackagePath() == PackagePath)
+	{
+		UPackage* CachedPackage = NameCache.FindExistingAssetPackage(BasePackageName, AssetName, T::StaticClass());
+		if (!CachedPackage)
+		{
+			CachedPackage = NameCache.CreateUniqueAssetPackage(BasePackageName, AssetName);
+		}
+
+		OutName = AssetName;
+		return CachedPackage;
+	}
 
 	const FString ObjectPath = BasePackageName + TEXT('.') + AssetName;
 	T* ExistingAsset = LoadObject<T>(nullptr, *ObjectPath, nullptr, LOAD_Quiet | LOAD_NoWarn);
@@ -50,3 +152,6 @@ UPackage* RetrieveAssetPackageAndName(UObject* Parent, const FString& PreferredN
 	OutName = AssetName;
 	return AssetPackage;
 }
+
+// Collects the geometry nodes of the whole node hierarchy, nested ones included, in the order they appear in the file.
+TArray<OGEX::GeometryNodeStructure*> GatherOpenGEXGeometryNodes(OGEX::OpenGexDataDescription* OpenGexDataDescriptionPtr);